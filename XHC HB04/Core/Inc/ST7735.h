@@ -3,6 +3,7 @@
 
 #include "fonts.h"
 #include "stm32f1xx_hal.h"
+#include "xhc_config.h"
 #include <stdbool.h>
 
 
@@ -25,6 +26,7 @@ extern SPI_HandleTypeDef hspi1;
 #define ST7735_HEIGHT 160
 
 #define DELAY 0x80
+#define ST7735_RESET_MS 5   // RST low time and wait after releasing it
 
 #define ST7735_MADCTL_MY  0x80
 #define ST7735_MADCTL_MX  0x40
@@ -54,6 +56,8 @@ extern SPI_HandleTypeDef hspi1;
 #define ST7735_RAMRD   0x2E
 
 #define ST7735_PTLAR   0x30
+#define ST7735_VSCRDEF 0x33
+#define ST7735_VSCSAD  0x37
 #define ST7735_COLMOD  0x3A
 #define ST7735_MADCTL  0x36
 
@@ -91,10 +95,31 @@ extern SPI_HandleTypeDef hspi1;
 #define WHITE   0xFFFF
 #define color565(r, g, b) (((r & 0xF8) << 8) | ((g & 0xFC) << 3) | ((b & 0xF8) >> 3))
 
+// RGB565 as it has to sit in a RAM pixel buffer. With 16-bit SPI frames the
+// peripheral shifts the native halfword out MSB first, so no swap is needed;
+// in 12-bit mode the driver repacks every pixel and wants them native too.
+// With 8-bit frames the bytes go out in memory order: high byte first, so on
+// the little-endian core the two bytes are swapped.
+#if ST7735_SPI16 && ST7735_RGB444
+#error "ST7735_RGB444 packs pixels into bytes, it needs 8-bit SPI frames"
+#endif
+#if ST7735_QUEUE && ST7735_RGB444
+#error "ST7735_RGB444 packs pixels on the CPU, the DMA command queue cannot chain it"
+#endif
+#if ST7735_SPI16 || ST7735_RGB444
+#define ST7735_WIRE16(c) ((uint16_t)(c))
+#else
+#define ST7735_WIRE16(c) ((uint16_t)((((c) & 0xFFu) << 8) | (((c) >> 8) & 0xFFu)))
+#endif
+
 // call before initializing any SPI devices
 void ST7735_Unselect();
 
 void ST7735_Init(uint8_t rotation);
+// Same bring-up without blocking: InitStart() pulls RST, then call
+// InitTick() from the main loop until it returns true.
+void ST7735_InitStart(uint8_t rotation);
+bool ST7735_InitTick(void);
 void ST7735_SetRotation(uint8_t m);
 void ST7735_DrawPixel(uint16_t x, uint16_t y, uint16_t color);
 void ST7735_WriteString(uint16_t x, uint16_t y, const char* str, FontDef font, uint16_t color, uint16_t bgcolor);
@@ -103,6 +128,89 @@ void ST7735_FillScreen(uint16_t color);
 void ST7735_DrawImage(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t* data);
 void ST7735_InvertColors(bool invert);
 
+// low level access for the strip compositor
+void ST7735_Select();
+void ST7735_SetAddressWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+void ST7735_WriteData(uint8_t* buff, size_t buff_size);
+// RAMWR payload: n pixels in ST7735_WIRE16 order
+void ST7735_WritePixels(const uint16_t* px, size_t n);
+
+// SetAddressWindow only sends CASET/RASET when they differ from the last
+// values sent. Anyone writing CASET/RASET behind its back has to call
+// ST7735_InvalidateWindow() afterwards.
+void ST7735_InvalidateWindow(void);
+
+// Re-sends the register state a glitch or a panel brown-out may have lost
+// (MADCTL, COLMOD) and drops the window cache. No visible effect.
+void ST7735_RefreshConfig(void);
+
+// Changes the SPI clock at runtime (SPI_BAUDRATEPRESCALER_2..256) once the
+// bus is idle. For tuning the panel link from the console.
+void ST7735_SetSpiPrescaler(uint32_t prescaler);
+
+// Hardware vertical scrolling. The controller scrolls along its 160 gate
+// lines, which is screen y only in the portrait rotations; the row math
+// assumes MY=0 (rotation 2). top/height are screen rows, the rest of the
+// 162-row GRAM becomes the fixed bottom area. SetScrollStart() takes the
+// GRAM row (screen coordinates, top..top+height-1) shown first.
+#define ST7735_GRAM_ROWS 162
+void ST7735_SetScrollArea(uint16_t top, uint16_t height);
+void ST7735_SetScrollStart(uint16_t row);
+// back to the unscrolled normal display mode
+void ST7735_ScrollOff(void);
+
+// Straight to the panel, past the shadow framebuffer and without wrapping.
+// For the scrolling console, whose GRAM rows no longer match screen rows.
+void ST7735_WriteStringDirect(uint16_t x, uint16_t y, const char* str, FontDef font, uint16_t color, uint16_t bgcolor);
+void ST7735_FillRectangleDirect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+
+// with ST7735_SPI16: fills of at least this many pixels run on the DMA
+#define ST7735_DMA_FILL_MIN 64
+
+// longest glyph run ST7735_WriteString streams through one window
+#define ST7735_MAX_RUN 24
+
+typedef struct {
+    uint32_t windows;           // SetAddressWindow calls
+    uint32_t cmd_bytes;         // CASET/RASET/RAMWR bytes actually sent
+    uint32_t cmd_bytes_saved;   // CASET/RASET bytes skipped by the cache
+} ST7735_WindowStats;
+
+void ST7735_GetWindowStats(ST7735_WindowStats *st, bool reset);
+
+// DMA blit of a buffer in ST7735_WIRE16 byte order. Returns immediately, CS is
+// released from the transfer-complete interrupt. The buffer must stay untouched
+// until ST7735_WaitDMA() returns (every blocking call waits on its own).
+// With ST7735_RGB444 a buffer in RAM is packed in place, i.e. consumed.
+void ST7735_DrawImageDMA(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t* data);
+void ST7735_WaitDMA(void);
+bool ST7735_DMABusy(void);
+
+#if ST7735_QUEUE
+// Command queue (ST7735_QUEUE=1). Entries are chained by the SPI DMA
+// complete interrupt, which also sets the window and drives DC/CS; the
+// caller returns as soon as the entry is queued. FillRectangle and
+// DrawImageDMA go through it. Blocking calls (Select) drain it first, so
+// WaitDMA/DMABusy now mean "queue empty".
+// A RAM buffer handed to DrawImageDMA keeps the old contract: it is free
+// again once the next DrawImageDMA from RAM has returned. QueueBlit makes
+// no such promise, poll the returned ticket with ST7735_QueueDone().
+uint32_t ST7735_QueueCommand(uint8_t cmd, const uint8_t *args, uint8_t n); // n <= 4
+uint32_t ST7735_QueueFill(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+uint32_t ST7735_QueueBlit(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t* data);
+bool ST7735_QueueDone(uint32_t ticket);
+
+typedef struct {
+    uint32_t entries;      // entries queued
+    uint32_t stalls;       // enqueues that found the queue full and waited
+    uint32_t drains;       // blocking calls that had to wait for the queue
+    uint16_t depth;        // entries waiting right now
+    uint16_t max_depth;    // high-water mark of depth
+} ST7735_QueueStats;
+
+void ST7735_GetQueueStats(ST7735_QueueStats *st, bool reset);
+#endif
+
 
 
 #endif // __ST7735_H__
@@ -4,17 +4,39 @@
 
 #include <stdint.h>
 
+// Characters first..last are stored as consecutive glyphs starting at glyph.
+typedef struct {
+    uint8_t first;
+    uint8_t last;
+    uint8_t glyph;
+} FontRange;
+
+// Glyph bitmaps are packed bitstreams: width*height bits, row by row, MSB
+// first, each glyph padded to stride bytes. Only the characters covered by
+// ranges are stored (tables generated by tools/gen_fonts.py); anything else
+// is drawn as glyph 0.
 typedef struct {
     const uint8_t width;
     uint8_t height;
-    const uint16_t *data;
+    uint8_t stride;
+    uint8_t nranges;
+    const uint8_t *data;
+    const FontRange *ranges;
 } FontDef;
 
 
 extern FontDef Font_7x10;
-extern FontDef Font_11x18;
-extern FontDef Font_16x26;
 extern FontDef Font_13x13;
 
 
+static inline const uint8_t *Font_Glyph(const FontDef *font, char ch) {
+    uint8_t c = (uint8_t)ch;
+    for(uint8_t i = 0; i < font->nranges; i++) {
+        const FontRange *r = &font->ranges[i];
+        if(c >= r->first && c <= r->last)
+            return &font->data[(uint16_t)(r->glyph + (c - r->first)) * font->stride];
+    }
+    return font->data;
+}
+
 #endif // __FONTS_H__
@@ -0,0 +1,30 @@
+/*
+ * xhc_bench.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Zyklenmessung über den DWT-Zähler des Cortex-M3 (1 Zyklus = 1/48 µs)
+ *      und ein Benchmark der Display-Zeichenprimitive.
+ */
+
+#ifndef INC_XHC_BENCH_H_
+#define INC_XHC_BENCH_H_
+
+#pragma once
+#include <stdint.h>
+#include "stm32f1xx_hal.h"
+#include "xhc_config.h"
+
+/* DWT->CYCCNT einschalten, ohne ihn zu nullen (mehrfacher Aufruf schadet nicht) */
+void XHC_Bench_Init(void);
+
+static inline uint32_t XHC_Bench_Cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+/* Alle Zeichenprimitive messen und die Tabelle auf dem Display zeigen.
+   Malt den ganzen Schirm voll – nur vor RenderScreen_Init aufrufen.
+   Setzt einen laufenden Zähler voraus (XHC_Boot_Start). */
+void XHC_Bench_Primitives(void);
+
+#endif /* INC_XHC_BENCH_H_ */
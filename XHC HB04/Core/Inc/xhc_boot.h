@@ -0,0 +1,40 @@
+/*
+ * xhc_boot.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Boot-Timeline: Zeitstempel (µs ab HAL_Init, DWT-Zähler) für die
+ *      Meilensteine bis zum ersten gültigen DRO-Wert. Nullpunkt ist
+ *      HAL_Init, nicht das Einschalten: Reset, Startup-Code und die
+ *      .data/.bss-Initialisierung davor sind nicht enthalten.
+ *      Auslesen per Debugger (s_marks) oder XHC_Boot_Trace().
+ */
+
+#ifndef INC_XHC_BOOT_H_
+#define INC_XHC_BOOT_H_
+
+#pragma once
+#include <stdint.h>
+
+#define XHC_BOOT_MAX_MARKS  8u
+
+typedef struct {
+    const char *tag;
+    uint32_t    us;
+} XHC_BootMark;
+
+/* direkt nach HAL_Init: Zeitbasis starten (Kern läuft noch auf HSI) */
+void XHC_Boot_Start(void);
+
+/* direkt nach SystemClock_Config: die bis dahin gezählten Zyklen gelten
+   mit dem alten Takt, ab jetzt mit SystemCoreClock (48 MHz) */
+void XHC_Boot_ClockChanged(void);
+
+/* Meilenstein festhalten; jeder Tag nur beim ersten Aufruf. Prüft dafür
+   per strcmp alle bisherigen Marken – Aufrufer in der Hauptschleife oder
+   im Renderpfad merken sich selbst, dass sie schon markiert haben. */
+void XHC_Boot_Mark(const char *tag);
+
+/* bisher erfasste Meilensteine */
+const XHC_BootMark *XHC_Boot_Trace(uint8_t *count);
+
+#endif /* INC_XHC_BOOT_H_ */
@@ -0,0 +1,296 @@
+/*
+ * xhc_config.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Build-Schalter der XHC-Firmware (per -D überschreibbar)
+ */
+
+#ifndef INC_XHC_CONFIG_H_
+#define INC_XHC_CONFIG_H_
+
+#pragma once
+
+/* ==== Strip-Compositor ====
+   Ein Band = so viele Zeilen, wie bei der Regionsbreite in XHC_STRIP_PIXELS
+   passen (160 px breit -> 16 Zeilen = 5 KB). Zwei Bänder: eins wird im RAM
+   gerendert, während das andere per DMA zum Panel läuft. */
+#ifndef XHC_STRIP_PIXELS
+#define XHC_STRIP_PIXELS   (160u * 16u)
+#endif
+
+#ifndef XHC_STRIP_BANDS
+#define XHC_STRIP_BANDS    2u
+#endif
+
+/* ==== Display-Treiber ====
+   1 = ST7735 schreibt direkt in SPI1->DR (TXE/BSY pollen) und schaltet
+   CS/DC über GPIOA->BSRR statt über HAL_SPI_Transmit/HAL_GPIO_WritePin.
+   DMA-Blits laufen in beiden Varianten über die HAL. */
+#ifndef ST7735_DRIVER_LL
+#define ST7735_DRIVER_LL   0
+#endif
+
+/* ==== 16-bit-SPI-Frames ====
+   1 = Pixeldaten (RAMWR) gehen als 16-bit-Frames raus, Kommandos weiter
+   als 8 bit (DFF wird bei Bedarf umgeschaltet). Pixelpuffer liegen dann
+   in nativer Byte-Reihenfolge (ST7735_WIRE16 ist die Identität), der DMA
+   überträgt Halbworte und große Flächen füllt er ohne Puffer (MINC aus). */
+#ifndef ST7735_SPI16
+#define ST7735_SPI16       0
+#endif
+
+/* ==== 12-bit-Farbe ====
+   1 = Panel im RGB444-Modus (COLMOD 0x03): zwei Pixel in drei Bytes, 25 %
+   weniger Bytes je Neuaufbau. Die UI-Farben sind alle in 4 bit je Kanal
+   darstellbar. Der Treiber packt beim Senden (RAM-Puffer für den DMA in
+   place), Puffer bleiben RGB565. Nur mit 8-bit-Frames (ST7735_SPI16=0). */
+#ifndef ST7735_RGB444
+#define ST7735_RGB444      0
+#endif
+
+/* ==== Display-Befehlsqueue ====
+   1 = Füllen, Blits und Einzelbefehle werden eingereiht; der SPI-DMA-
+   Complete-Interrupt setzt Fenster, schaltet DC/CS und startet den nächsten
+   Eintrag selbst. RenderScreen reiht dann nur noch ein, gewartet wird erst
+   beim nächsten blockierenden Aufruf (Glyphen) oder bei voller Queue.
+   Tiefe anhand ST7735_GetQueueStats() (max_depth, stalls) wählen,
+   Zweierpotenz, 24 Byte je Eintrag. Nicht mit ST7735_RGB444.
+   IRQ-Last (gerechnet für 48 MHz, Prescaler 16 = 3 MHz SPI, nicht gemessen):
+   8-bit-Frames: auch Befehl und Fenster laufen per DMA, je Stück (Befehls-
+   byte bzw. Argumente) ein Interrupt von ca. 10 us (HAL-DMA-Ende mit BSY-
+   Warten plus Neustart), höchstens fünf Stücke je Eintrag. Füllungen
+   wiederholen eine Zeile (160 Pixel, 320 Byte RAM), also ein Interrupt je
+   ~0,85 ms Bus; ein Farbwechsel kostet einmal ca. 5 us für das Muster.
+   Mit ST7735_SPI16 ist der Kanal halbwortbreit: Fenster und Befehle gehen
+   blockierend aus dem Interrupt, schlimmstenfalls 11 Byte = ca. 40 us. */
+#ifndef ST7735_QUEUE
+#define ST7735_QUEUE       0
+#endif
+#ifndef ST7735_QUEUE_DEPTH
+#define ST7735_QUEUE_DEPTH 16u
+#endif
+
+/* ==== Benchmark ====
+   1 = nach ST7735_Init alle Zeichenprimitive mit dem DWT-Zykluszähler
+   messen und die Tabelle XHC_BENCH_HOLD_MS lang anzeigen. Vergleich
+   HAL/LL: je einmal mit ST7735_DRIVER_LL=0 und =1 bauen. */
+#ifndef XHC_BENCH
+#define XHC_BENCH          0
+#endif
+
+#ifndef XHC_BENCH_HOLD_MS
+#define XHC_BENCH_HOLD_MS  5000u
+#endif
+
+/* ==== Ziffern-Sprites ====
+   1 = geänderte Zeichen der Werte-Zeilen direkt als vorgerasterte
+   RGB565-Zelle aus dem Flash blitten (xhc_digits.c, 14 x 182 Byte). */
+#ifndef XHC_DIGIT_SPRITES
+#define XHC_DIGIT_SPRITES  1
+#endif
+
+/* ==== Layout-Bild ====
+   1 = statischen Hintergrund des 6-Werte-Layouts aus dem RLE-Bild
+   xhc_layout_img.c (677 Byte Flash) bandweise entpacken statt ihn aus
+   Einzelprimitiven aufzubauen. Nach Layout-Änderungen
+   tools/gen_layout_image.py neu laufen lassen. */
+#ifndef XHC_LAYOUT_IMAGE
+#define XHC_LAYOUT_IMAGE   1
+#endif
+
+/* ==== Selbstheilung ====
+   Diff-Rendering malt unveränderte Zellen nie neu, Störungen im Schalt-
+   schrank bleiben sonst stehen. 1 = in Leerlauf-Frames alle
+   XHC_HEAL_PERIOD_MS einen Streifen von XHC_HEAL_ROWS Zeilen (Layout +
+   Werte/Bars aus den Caches) neu komponieren und senden, reihum über den
+   ganzen Schirm: 128/8 x 200 ms = 3,2 s je Durchlauf. Kein Wischen, der
+   Streifen geht fertig komponiert in einem DMA raus.
+   XHC_HEAL_REGS = 1: je Durchlauf zusätzlich MADCTL/COLMOD neu senden. */
+#ifndef XHC_HEAL
+#define XHC_HEAL           1
+#endif
+#ifndef XHC_HEAL_ROWS
+#define XHC_HEAL_ROWS      8u
+#endif
+#ifndef XHC_HEAL_PERIOD_MS
+#define XHC_HEAL_PERIOD_MS 200u
+#endif
+#ifndef XHC_HEAL_REGS
+#define XHC_HEAL_REGS      1
+#endif
+
+/* ==== SOF-Takt ====
+   1 = Hauptschleife läuft im 1-ms-Raster des USB-Hosts: nach jedem SOF
+   (Eingaben/IN-Report im SOF-Interrupt bereits bereitgelegt) wird
+   gerendert, die SPI-Bursts liegen im Rest des Frames. Ohne SOFs
+   (Suspend, nicht eingesteckt) wie bisher HAL_Delay(1).
+   0 = immer HAL_Delay(1), SOF-Statistik läuft trotzdem. */
+#ifndef XHC_SOF_SYNC
+#define XHC_SOF_SYNC       1
+#endif
+
+/* ==== Composite-USB ====
+   1 = neben dem HID-Interface (Interface 0, EP 0x81/0x01 – das, was
+   LinuxCNC öffnet) eine CDC-ACM-Schnittstelle (Interface 1+2) mit
+   Befehlskonsole (xhc_console.c) und Telemetrie. Das Gerät meldet sich
+   dann als Composite mit IAD. 0 = reines HID-Gerät wie bisher. */
+#ifndef XHC_USB_CDC
+#define XHC_USB_CDC        1
+#endif
+
+/* CDC-Ringe in Byte: Senden (Konsole, Telemetrie), Empfang (Befehlszeilen).
+   Mit XHC_SHADOW_FB kleiner, siehe RAM-Budget beim Schatten-Framebuffer;
+   "help" wird dann am Ende abgeschnitten. */
+#ifndef XHC_CDC_TX_RING
+#define XHC_CDC_TX_RING    (XHC_SHADOW_FB ? 128u : 512u)
+#endif
+#ifndef XHC_CDC_RX_RING
+#define XHC_CDC_RX_RING    (XHC_SHADOW_FB ? 64u : 128u)
+#endif
+
+/* ==== Telemetrie ====
+   1 = Ereignisse (Report rein/verworfen, Frame fertig, Zeichnen Start/
+   Ende, Report raus) als 8-Byte-Datensätze in einen Ring, über die CDC-
+   Schnittstelle geleert (Konsole "tel on"). Kostet je Ereignis einen
+   kurzen IRQ-gesperrten Eintrag, ausgeschaltet nur einen Vergleich.
+   XHC_TELEMETRY_RECORDS Datensätze = 8 Byte RAM je Eintrag; mit
+   XHC_SHADOW_FB nur 16 (Verluste zählt "tel"). */
+#ifndef XHC_TELEMETRY
+#define XHC_TELEMETRY      XHC_USB_CDC
+#endif
+#ifndef XHC_TELEMETRY_RECORDS
+#define XHC_TELEMETRY_RECORDS  (XHC_SHADOW_FB ? 16u : 128u)
+#endif
+#if XHC_TELEMETRY && !XHC_USB_CDC
+#error "XHC_TELEMETRY braucht die CDC-Schnittstelle (XHC_USB_CDC=1)"
+#endif
+
+/* ==== Pendant-Protokoll ====
+   Welches Frame-Layout der Host über Feature 0x06 schickt und welche
+   USB-PID das Gerät dafür meldet (xhc_proto.h):
+     XHC_PROTO_HB03     HB03, Positionen mit 2 Nachkommastellen
+     XHC_PROTO_HB04     HB04, 37-Byte-Frame (bisheriges Verhalten)
+     XHC_PROTO_WHB04B4  WHB04B-4, drei Zeilen je Frame, Achsen X Y Z A
+     XHC_PROTO_WHB04B6  WHB04B-6, drei Zeilen je Frame, X Y Z A B C
+   XHC_USB_PID überschreibt die PID der Variante. */
+#define XHC_PROTO_HB03     1
+#define XHC_PROTO_HB04     2
+#define XHC_PROTO_WHB04B4  3
+#define XHC_PROTO_WHB04B6  4
+#ifndef XHC_PROTO
+#define XHC_PROTO          XHC_PROTO_HB04
+#endif
+
+/* WHB04B: Achsgruppe, zu der die drei Zeilen eines Frames gehören
+   (0 = X/Y/Z, 1 = A/B/C). Der Frame selbst sagt es nicht, die Gruppe
+   folgt dem Achswahlschalter des Host-Treibers; zur Laufzeit per
+   Konsole "group xyz|abc" bzw. XHC_Proto_SetAxisGroup(). */
+#ifndef XHC_WHB04B_GROUP
+#define XHC_WHB04B_GROUP   0
+#endif
+
+/* ==== Achsen auf dem Display ====
+   3..6 Achsen (X Y Z A B C), das Layout rechnet xhc_layout.c aus:
+   3 = klassisch, 4 = kleinere Schrift, 5..6 = WC und MC nebeneinander.
+   0 = so viele, wie die Pendant-Variante liefert (XHC_PROTO_AXES).
+   Zur Laufzeit: RenderScreen_SetAxes(), Konsole "axes". */
+#ifndef XHC_DISPLAY_AXES
+#define XHC_DISPLAY_AXES   0
+#endif
+
+/* ==== Bewegungsschätzer ====
+   1 = Alpha-Beta-Filter über die Frame-Positionen (xhc_estim.c): Ist-
+   Vorschub und Bahnbeschleunigung in der oberen Footer-Zeile, Details
+   in der Konsole ("motion"). alpha/beta in Q8 (256 = 1.0); 128/43 ist
+   kritisch gedämpft (beta = alpha²/(2-alpha)). Residuen über
+   XHC_EST_JUMP (1/10000 Einheit) gelten als Sprung, Pausen über
+   XHC_EST_GAP_MS als Stillstand. */
+#ifndef XHC_ESTIMATOR
+#define XHC_ESTIMATOR      1
+#endif
+#ifndef XHC_EST_ALPHA
+#define XHC_EST_ALPHA      128
+#endif
+#ifndef XHC_EST_BETA
+#define XHC_EST_BETA       43
+#endif
+#ifndef XHC_EST_JUMP
+#define XHC_EST_JUMP       200000
+#endif
+#ifndef XHC_EST_GAP_MS
+#define XHC_EST_GAP_MS     500u
+#endif
+
+/* ==== Interpolation zwischen Frames ====
+   1 = während einer Bewegung zählt die Anzeige zwischen zwei Host-Frames
+   mit der geschätzten Geschwindigkeit weiter (XHC_ESTIMATOR), alle
+   XHC_INTERP_PERIOD_MS statt im Raster des Rate-Limits. Ein neuer Frame
+   setzt auf den echten Wert zurück, Stillstand ebenso; länger als
+   XHC_INTERP_MAX_MS ohne Frame wird nicht weiter extrapoliert.
+   SPI-Aufwand je Takt: nur Felder bewegter Achsen, nur geänderte
+   Zeichen, Takt entfällt solange der DMA noch läuft. Kein USB-Verkehr.
+   Harter Stopp: der Schätzer hinkt nach, die Anzeige läuft bis zum
+   nächsten Frame über das Ziel (20 Frames/s, 500 mm/s² aus 3000 mm/min:
+   ca. 1,6 mm für einen Takt). Nachrechnen: tools/xhc_estim.py. */
+#ifndef XHC_INTERP
+#define XHC_INTERP         0
+#endif
+#ifndef XHC_INTERP_PERIOD_MS
+#define XHC_INTERP_PERIOD_MS  40u
+#endif
+#ifndef XHC_INTERP_MAX_MS
+#define XHC_INTERP_MAX_MS  100u
+#endif
+#if XHC_INTERP && !XHC_ESTIMATOR
+#error "XHC_INTERP braucht den Bewegungsschätzer (XHC_ESTIMATOR=1)"
+#endif
+
+/* ==== Zoom-DRO ====
+   Feld (0..n-1 = WC, n..2n-1 = MC bei n Achsen, also 0..5 = WC X/Y/Z,
+   MC X/Y/Z bei 3), das nach dem Start groß als 7-Segment-Anzeige
+   erscheint; -1 = normales Layout.
+   Zur Laufzeit: RenderScreen_SetZoom(). */
+#ifndef XHC_ZOOM_AXIS
+#define XHC_ZOOM_AXIS      (-1)
+#endif
+
+/* ==== USB-Diagnoseseite ====
+   1 = ist das Gerät länger als XHC_USB_LOG_MS nicht konfiguriert (kein
+   Host, Kabel ab, Suspend), zeigt das Panel statt der eingefrorenen DRO
+   das Scroll-Log mit den USB-Zustandswechseln. Sobald der Host das Gerät
+   wieder konfiguriert hat, kommt das normale Layout zurück. */
+#ifndef XHC_USB_LOG
+#define XHC_USB_LOG        1
+#endif
+#ifndef XHC_USB_LOG_MS
+#define XHC_USB_LOG_MS     2000u
+#endif
+
+/* ==== 4-bit-Schatten-Framebuffer ====
+   1 = alle GFX-/Text-Primitive zeichnen in einen 160x128x4bpp-Puffer
+   (10 KB, Palette mit 16 Einträgen). XHC_Shadow_Flush() schickt nur die
+   wirklich geänderten Pixel-Spans als RGB565 zum Panel, der Host kann den
+   Puffer als Screenshot über USB auslesen. Ersetzt die Strip-Bänder (der
+   Compositor rendert dann in kleine Index-Bänder und committet diffbasiert). */
+#ifndef XHC_SHADOW_FB
+#define XHC_SHADOW_FB      0
+#endif
+
+/* Index-Band für den Compositor im Schattenbetrieb (1 Byte je Pixel) */
+#ifndef XHC_SHADOW_BAND_PIXELS
+#define XHC_SHADOW_BAND_PIXELS  (160u * 8u)
+#endif
+
+/* RGB565-Zeilenpuffer für den Flush (je Puffer, zwei im Wechsel) */
+#ifndef XHC_SHADOW_LINE_PIXELS
+#define XHC_SHADOW_LINE_PIXELS  320u
+#endif
+
+/* RAM-Budget F103C8 (20 KB, davon 1,5 KB Stack/Heap laut Linkerskript):
+   Grundausbau ~17,1 KB statisch. Der Schatten braucht ~10 KB statt der
+   Strip-Bänder, mit den vollen CDC-/Telemetrie-Ringen wären es ~20,0 KB.
+   Deshalb schrumpfen mit XHC_SHADOW_FB die Vorgaben von XHC_CDC_TX_RING
+   (512 -> 128), XHC_CDC_RX_RING (128 -> 64) und XHC_TELEMETRY_RECORDS
+   (128 -> 16): ~18,6 KB statisch + 1,5 KB. */
+
+#endif /* INC_XHC_CONFIG_H_ */
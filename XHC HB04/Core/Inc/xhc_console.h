@@ -0,0 +1,25 @@
+/*
+ * xhc_console.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Befehlskonsole über die CDC-ACM-Schnittstelle (XHC_USB_CDC=1):
+ *      Statistiken (RX/Frames, SOF, SPI-Fenster, Queue, Boot-Timeline)
+ *      und Live-Tuning (Rate-Limit, SPI-Takt, Layout) ohne SWD-Probe.
+ *      Terminal auf /dev/ttyACMx öffnen, "help" + Enter.
+ */
+
+#ifndef INC_XHC_CONSOLE_H_
+#define INC_XHC_CONSOLE_H_
+
+#pragma once
+#include <stdint.h>
+#include "xhc_config.h"
+
+/* Hauptschleife: empfangene Zeichen sammeln, fertige Zeilen ausführen.
+   Eine Zeile je Aufruf, Ausgabe nicht blockierend (zu viel wird verworfen). */
+void XHC_Console_Poll(void);
+
+/* formatierte Ausgabe auf die Konsole (max. 96 Zeichen je Aufruf) */
+void XHC_Console_Printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+#endif /* INC_XHC_CONSOLE_H_ */
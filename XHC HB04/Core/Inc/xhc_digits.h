@@ -0,0 +1,32 @@
+/*
+ * xhc_digits.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Vorgerasterte DRO-Zeichen (Font_13x13, schwarz auf weiß) im Flash.
+ *      Eine geänderte Ziffer ist damit ein einziger DMA-Blit direkt aus dem
+ *      Flash, ohne Bitmap-Expansion auf der CPU. Tabelle erzeugt von
+ *      tools/gen_digit_sprites.py.
+ */
+
+#ifndef INC_XHC_DIGITS_H_
+#define INC_XHC_DIGITS_H_
+
+#pragma once
+#include <stdint.h>
+#include "ST7735.h"
+
+/* Zelle = Zeichenraster der Werte-Zeilen (Glyphen überlappen bei 13 px) */
+#define XHC_DIGIT_W      7u
+#define XHC_DIGIT_H      13u
+#define XHC_DIGIT_COUNT  14u
+
+#define XHC_DIGIT_FG     BLACK
+#define XHC_DIGIT_BG     WHITE
+
+/* Pixel so abgelegt, wie sie über den SPI gehen */
+#define XHC_DIGIT_PX(c)  ST7735_WIRE16(c)
+
+/* Sprite (XHC_DIGIT_W x XHC_DIGIT_H) für c, 0 wenn nicht im Cache */
+const uint16_t* XHC_Digit_Sprite(char c);
+
+#endif /* INC_XHC_DIGITS_H_ */
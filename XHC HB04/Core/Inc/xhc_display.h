@@ -14,7 +14,24 @@
 /* Init und bis zu 6 Content-Zeilen:
    Zeile 0 = Header, Zeilen 1..6 = Inhalt */
 void XHC_Display_Init(void);
+
+/* 1, sobald die nicht-blockierende Panel-Init (Boot_Tick) fertig ist und
+   XHC_Display_Init lief; vorher darf außer ST7735_InitTick nichts aufs SPI */
+uint8_t XHC_Display_Ready(void);
 void XHC_Display_SetHeader(const char *text);
 void XHC_Display_SetLine(uint8_t line_idx, const char *text);  // 1..6
 
+/* Scroll-Log (Ereignis-/Diagnoseseite) im Hochformat: feste Titelzeile,
+   darunter XHC_LOG_ROWS Zeilen im Hardware-Scrollbereich (VSCRDEF/VSCSAD).
+   Eine neue Zeile kostet einen Scrollbefehl + eine Glyphenzeile.
+   Solange das Log offen ist (XHC_Display_LogActive), pausiert RenderScreen()
+   und zeichnet auch kein Layout; nach XHC_Display_LogEnd() das Layout mit
+   RenderScreen_Restore() neu aufbauen. Aufrufer: USB-Diagnoseseite (main.c),
+   Konsole "log". */
+#define XHC_LOG_ROWS  12
+void XHC_Display_LogBegin(const char *title);
+void XHC_Display_Log(const char *text);
+void XHC_Display_LogEnd(void);
+uint8_t XHC_Display_LogActive(void);
+
 #endif /* INC_XHC_DISPLAY_H_ */
@@ -0,0 +1,69 @@
+/*
+ * xhc_estim.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Bewegungsschätzer: Alpha-Beta-Filter je Achse über die Positionen
+ *      aufeinanderfolgender Frames (XHC_MachineState, 1/10000 Einheit).
+ *      Liefert Geschwindigkeit und Beschleunigung je Achse, den Bahn-
+ *      vorschub über X/Y/Z und beim Bremsen den verbleibenden Weg.
+ *      Nur Ganzzahlrechnung: je Frame eine 32-bit-Division, je Achse ein
+ *      paar 32x32->64-Multiplikationen, eine Wurzel für den Vorschub.
+ *
+ *      Vorhersage  xp = x + v*dt
+ *      Residuum    r  = z - xp
+ *      Korrektur   x  = xp + alpha*r,   v += beta*r/dt
+ *
+ *      alpha/beta in Q8 (xhc_config.h). Sprünge (Nullpunkt gesetzt,
+ *      Referenzfahrt) und Pausen > XHC_EST_GAP_MS setzen die Achse zurück.
+ */
+
+#ifndef INC_XHC_ESTIM_H_
+#define INC_XHC_ESTIM_H_
+
+#pragma once
+#include <stdint.h>
+#include "xhc_config.h"
+#include "xhc_proto.h"
+
+typedef struct {
+    int32_t  pos[XHC_AXES];    /* gefilterte Position, 1/10000 Einheit */
+    int32_t  vel[XHC_AXES];    /* Einheiten/s */
+    int32_t  acc[XHC_AXES];    /* Einheiten/s², geglättet */
+    uint32_t speed;            /* Bahngeschwindigkeit X/Y/Z, Einheiten/s */
+    int32_t  path_acc;         /* Bahnbeschleunigung, Einheiten/s² (< 0 = bremst) */
+    uint8_t  moving;           /* Maske der Achsen mit v != 0 */
+} XHC_Motion;
+
+#if XHC_ESTIMATOR
+
+void XHC_Est_Reset(void);
+
+/* Neue Positionen (alle XHC_AXES) zum Zyklenstand cyc (DWT) einrechnen */
+void XHC_Est_Update(const int32_t pos[XHC_AXES], uint32_t cyc);
+
+/* Hauptschleife: ohne Frames länger als XHC_EST_GAP_MS gilt alles als stehend */
+void XHC_Est_Tick(uint32_t cyc);
+
+const XHC_Motion *XHC_Est_Motion(void);
+
+/* Weg der Achse seit dem letzten Frame bis cyc aus v und a, 1/10000
+   Einheit. Höchstens max_ms weit, beim Bremsen nur bis zum Stillstand;
+   0 für stehende Achsen. */
+int32_t XHC_Est_Extrapolate(uint8_t axis, uint32_t cyc, uint16_t max_ms);
+
+/* Bahnvorschub in Einheiten/min (mm/min bei mm-Maschinen) */
+uint32_t XHC_Est_FeedPerMin(void);
+
+/* Restweg bis Stillstand bei aktueller Verzögerung, 1/10000 Einheit;
+   0 wenn nicht gebremst wird */
+uint32_t XHC_Est_DistToGo(void);
+
+#else
+
+static inline void XHC_Est_Reset(void) {}
+static inline void XHC_Est_Update(const int32_t pos[XHC_AXES], uint32_t cyc) { (void)pos; (void)cyc; }
+static inline void XHC_Est_Tick(uint32_t cyc) { (void)cyc; }
+
+#endif
+
+#endif /* INC_XHC_ESTIM_H_ */
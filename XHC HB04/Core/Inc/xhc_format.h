@@ -24,5 +24,12 @@ void int2strprec( int32_t v, char padd, char *o );
 
 void xhc2string_align10(uint16_t iint, uint16_t ifrac, char *out10);
 
+/* wie xhc2string_align10, Wert aber als Festkomma in 1/10000 (XHC_MachineState) */
+void fixed4_align10(int32_t v, char *out10);
+
+/* Dezimal ohne Vorzeichen und ohne Tausenderpunkte, rechtsbündig auf
+   mindestens width Zeichen mit pad (' ' oder '0'). Rückgabe: Länge. */
+uint8_t uint2str(uint32_t value, uint8_t width, char pad, char *o);
+
 
 #endif /* INC_XHC_FORMAT_H_ */
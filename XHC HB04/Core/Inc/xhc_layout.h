@@ -0,0 +1,52 @@
+/*
+ * xhc_layout.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Layout-Engine für den Wertebereich über der blauen Leiste: rechnet
+ *      für 3..6 Achsen Zeilenlagen, Font und Spalten aus. Felder sind
+ *      durchnummeriert, 0..n-1 = WC, n..2n-1 = MC (n = Achsen), jedes Feld
+ *      ist eine 10-Zeichen-Zelle auf dem 7-px-Raster – der Diff je Feld
+ *      im Renderer bleibt damit unabhängig von der Achszahl.
+ *
+ *      Kandidaten, der erste, der passt, gewinnt:
+ *        gestapelt, Font_13x13   WC über MC (3 Achsen, = xhc_layout_img.c)
+ *        gestapelt, Font_7x10    WC über MC, engere Zeilen (4 Achsen)
+ *        nebeneinander, 7x10     WC | MC in zwei Spalten (5..6 Achsen)
+ */
+
+#ifndef INC_XHC_LAYOUT_H_
+#define INC_XHC_LAYOUT_H_
+
+#pragma once
+#include <stdint.h>
+#include "fonts.h"
+
+#define XHC_LAYOUT_MIN_AXES   3u
+#define XHC_LAYOUT_MAX_AXES   6u
+#define XHC_LAYOUT_MAX_FIELDS (2u * XHC_LAYOUT_MAX_AXES)
+
+typedef enum {
+    XHC_LAY_STACK = 0,   /* WC-Block, Trennstrich, MC-Block */
+    XHC_LAY_SIDE  = 1,   /* WC links, MC rechts, Strich unter den Köpfen */
+} XHC_LayoutMode;
+
+typedef struct {
+    uint8_t        axes;                          /* n */
+    uint8_t        fields;                        /* 2n */
+    uint8_t        mode;                          /* XHC_LayoutMode */
+    const FontDef *font;                          /* Werte und Labels */
+    uint8_t        val_x[XHC_LAYOUT_MAX_FIELDS];  /* erste Zeichenzelle */
+    uint8_t        val_y[XHC_LAYOUT_MAX_FIELDS];
+    uint8_t        lbl_x[XHC_LAYOUT_MAX_FIELDS];  /* Achsbuchstabe */
+    uint8_t        grp_x[2], grp_y[2];            /* "WC" / "MC" */
+    uint8_t        rule_y;                        /* Trennstrich, volle Breite */
+} XHC_Layout;
+
+/* Layout für axes (auf 3..6 begrenzt) in w x h Pixel berechnen */
+void XHC_Layout_Compute(XHC_Layout *l, uint8_t axes, uint16_t w, uint16_t h);
+
+/* Achsbuchstabe und Gruppe eines Feldes */
+char    XHC_Layout_AxisChar(const XHC_Layout *l, uint8_t field);
+uint8_t XHC_Layout_IsMC(const XHC_Layout *l, uint8_t field);
+
+#endif /* INC_XHC_LAYOUT_H_ */
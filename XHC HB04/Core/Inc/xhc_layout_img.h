@@ -0,0 +1,20 @@
+/*
+ * xhc_layout_img.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Statisches DRO-Layout (Labels, Trennstrich, Fußzeile, Bar-Rahmen)
+ *      als RLE-Palettenbild im Flash. Ein kompletter Hintergrund ist damit
+ *      ein Entpacken + DMA je Strip-Band, deterministisch und ohne die
+ *      Einzelprimitive. Tabelle erzeugt von tools/gen_layout_image.py.
+ */
+
+#ifndef INC_XHC_LAYOUT_IMG_H_
+#define INC_XHC_LAYOUT_IMG_H_
+
+#pragma once
+#include "xhc_strip.h"
+
+/* 160x128, normales 6-Werte-Layout (nicht Zoom) */
+extern const XHC_RleImage XHC_Layout_Image;
+
+#endif /* INC_XHC_LAYOUT_IMG_H_ */
@@ -0,0 +1,96 @@
+/*
+ * xhc_proto.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Protokollschicht: Frame der Pendant-Variante (XHC_PROTO in
+ *      xhc_config.h) -> ein gemeinsamer Maschinenzustand. Der Renderer
+ *      kennt keine Offsets mehr, nur noch XHC_MachineState und die
+ *      Änderungsmaske, die jeder Decode liefert.
+ *
+ *      Variante    Frame (Feature 0x06, 7-Byte-Chunks)              Achsen
+ *      HB03        FE FD day, 6 x {u16 int, u8 frac}, Overrides...  31 B, WC+MC XYZ
+ *      HB04        FE FD day, 6 x {u16 int, u16 frac}, Overrides... 37 B, WC+MC XYZ
+ *      WHB04B-4/6  FE FD seed flags, 3 x {u16 int, u16 frac},       21 B, 3 Zeilen
+ *                  feed, spindle                                   (XYZ oder ABC)
+ *
+ *      Vorzeichen jeweils im MSB des Nachkommateils. Die Schnellmodus-
+ *      Reports 0x0D/0x0E (usbd_custom_hid_if.h) tragen immer das HB04-
+ *      Layout und laufen über XHC_Proto_DecodeHB04.
+ */
+
+#ifndef INC_XHC_PROTO_H_
+#define INC_XHC_PROTO_H_
+
+#pragma once
+#include <stdint.h>
+#include "xhc_config.h"
+
+#define XHC_AXES   6u                 /* X Y Z A B C */
+
+typedef struct {
+    int32_t  wc[XHC_AXES];            /* Werkstück-Koordinaten, 1/10000 Einheit */
+    int32_t  mc[XHC_AXES];            /* Maschinen-Koordinaten */
+    uint16_t feed_ovr;                /* % */
+    uint16_t spindle_ovr;             /* % */
+    uint16_t feedrate;
+    uint16_t sspeed;
+    uint8_t  step_mul;
+    uint8_t  state;
+    uint8_t  day;
+} XHC_MachineState;
+
+/* Änderungsmaske eines Decodes */
+#define XHC_CH_WC(i)     (1u << (i))
+#define XHC_CH_MC(i)     (1u << (XHC_AXES + (i)))
+#define XHC_CH_FEED      (1u << 12)   /* Feed-Override, Vorschub */
+#define XHC_CH_SPINDLE   (1u << 13)   /* Spindel-Override, Drehzahl */
+#define XHC_CH_MISC      (1u << 14)   /* Schrittweite, Status, Tag */
+#define XHC_CH_ALL       0x7FFFu
+#define XHC_CH_WC_ALL    0x003Fu
+#define XHC_CH_MC_ALL    0x0FC0u
+
+/* ---- konfigurierte Variante, zur Übersetzungszeit aufgelöst ---- */
+#if XHC_PROTO == XHC_PROTO_HB03
+#define XHC_PROTO_FRAME_SIZE  31u
+#define XHC_PROTO_AXES        3u
+#define XHC_PROTO_PID         0xEB70u
+#elif XHC_PROTO == XHC_PROTO_HB04
+#define XHC_PROTO_FRAME_SIZE  37u
+#define XHC_PROTO_AXES        3u
+#define XHC_PROTO_PID         0xEB70u
+#elif XHC_PROTO == XHC_PROTO_WHB04B4
+#define XHC_PROTO_FRAME_SIZE  21u
+#define XHC_PROTO_AXES        4u
+#define XHC_PROTO_PID         0xEB93u
+#elif XHC_PROTO == XHC_PROTO_WHB04B6
+#define XHC_PROTO_FRAME_SIZE  21u
+#define XHC_PROTO_AXES        6u
+#define XHC_PROTO_PID         0xEB93u
+#else
+#error "XHC_PROTO: unbekannte Pendant-Variante"
+#endif
+
+/* USB-PID, die der Host für die Variante erwartet (überschreibbar) */
+#ifndef XHC_USB_PID
+#define XHC_USB_PID           XHC_PROTO_PID
+#endif
+
+/* Grundzustand: alles 0, Overrides 100 % */
+void XHC_Proto_Reset(XHC_MachineState *ms);
+
+/* Frame der konfigurierten Variante übernehmen. Rückgabe: 1 = gültig,
+   *changed = Felder, die sich dabei tatsächlich geändert haben. */
+uint8_t XHC_Proto_Decode(const uint8_t *frame, uint8_t len,
+                         XHC_MachineState *ms, uint16_t *changed);
+
+/* HB04-Layout (37 Byte), unabhängig von XHC_PROTO: Schnellmodus/Delta */
+uint8_t XHC_Proto_DecodeHB04(const uint8_t *frame, uint8_t len,
+                             XHC_MachineState *ms, uint16_t *changed);
+
+/* WHB04B: der Achswahlschalter sitzt am Pendant, der Host schickt nur
+   die drei Zeilen der gewählten Gruppe. 0 = X/Y/Z, 1 = A/B/C.
+   Start mit XHC_WHB04B_GROUP, umschalten per Konsole "group xyz|abc". */
+void    XHC_Proto_SetAxisGroup(uint8_t abc);
+uint8_t XHC_Proto_AxisGroup(void);
+
+#endif /* INC_XHC_PROTO_H_ */
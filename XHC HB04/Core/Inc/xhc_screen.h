@@ -9,6 +9,7 @@
 #define INC_XHC_SCREEN_H_
 
 #pragma once
+#include <stdint.h>
 
 /* Einmal aufrufen nach Display-Init */
 void RenderScreen_Init(void);
@@ -16,5 +17,22 @@ void RenderScreen_Init(void);
 /* In der main-While-Schleife aufrufen */
 void RenderScreen(void);
 
+/* Einen Wert (Feld 0..n-1 = WC, n..2n-1 = MC, n = Achsen) groß als
+   7-Segment-Anzeige zeigen, -1 = zurück zum normalen Layout */
+void RenderScreen_SetZoom(int8_t idx);
+
+/* Anzahl angezeigter Achsen (3..6), Layout wird neu berechnet */
+void    RenderScreen_SetAxes(uint8_t axes);
+uint8_t RenderScreen_Axes(void);
+
+/* Anzeige komplett wiederherstellen (nach Display-Störung, Seitenwechsel):
+   Hintergrund neu, alle Werte beim nächsten RenderScreen() neu */
+void RenderScreen_Restore(void);
+
+/* Mindestabstand zwischen zwei Updates derselben Quelle in ms
+   (Vorgabe UI_MIN_PERIOD_MS, 0 = jedes Update sofort) */
+void     RenderScreen_SetRateLimit(uint16_t ms);
+uint16_t RenderScreen_RateLimit(void);
+
 
 #endif /* INC_XHC_SCREEN_H_ */
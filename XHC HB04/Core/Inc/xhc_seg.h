@@ -0,0 +1,60 @@
+/*
+ * xhc_seg.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Skalierbare 7-Segment-Ziffern aus gefüllten Rechtecken. Jede Zelle
+ *      merkt sich ihre Segmentmaske; beim Update werden nur die Segmente
+ *      neu gefüllt, die umschalten (max. 8 Rechtecke je Ziffer).
+ */
+
+#ifndef INC_XHC_SEG_H_
+#define INC_XHC_SEG_H_
+
+#pragma once
+#include <stdint.h>
+
+#define XHC_SEG_MAX_CELLS  10u
+
+/* Segmentbits: a oben, b rechts oben, c rechts unten, d unten,
+   e links unten, f links oben, g Mitte, dp Dezimalpunkt */
+#define XHC_SEG_A   0x01u
+#define XHC_SEG_B   0x02u
+#define XHC_SEG_C   0x04u
+#define XHC_SEG_D   0x08u
+#define XHC_SEG_E   0x10u
+#define XHC_SEG_F   0x20u
+#define XHC_SEG_G   0x40u
+#define XHC_SEG_DP  0x80u
+
+typedef struct {
+    uint16_t x, y;      /* links oben der ersten Zelle */
+    uint8_t  w, h;      /* Ziffer ohne Dezimalpunkt */
+    uint8_t  t;         /* Segmentstärke */
+    uint8_t  pitch;     /* Zellenabstand (Ziffer + Punkt + Luft) */
+    uint8_t  cells;
+    uint16_t fg, bg;
+    uint8_t  mask[XHC_SEG_MAX_CELLS];   /* Stand auf dem Panel */
+} XHC_SegField;
+
+/* Geometrie aus Ziffernbreite/-höhe ableiten; Stärke ~ w/4 */
+void XHC_Seg_Init(XHC_SegField *f, uint16_t x, uint16_t y, uint8_t w, uint8_t h,
+                  uint8_t cells, uint16_t fg, uint16_t bg);
+
+/* Breite des ganzen Felds in Pixeln */
+uint16_t XHC_Seg_Width(const XHC_SegField *f);
+
+/* Feld mit bg füllen, Masken auf 0 (nach Layoutwechsel) */
+void XHC_Seg_Clear(XHC_SegField *f);
+
+/* Text darstellen: '0'-'9', '-', ' ', '#'; '.' setzt den Punkt der
+   vorherigen Zelle. Nur umschaltende Segmente werden gezeichnet. */
+void XHC_Seg_Draw(XHC_SegField *f, const char *s);
+
+/* Stand des Felds (gespeicherte Masken) in das aktuelle Strip-Band malen,
+   ohne Masken zu ändern – nur innerhalb eines XHC_StripRenderFn */
+void XHC_Seg_Strip(const XHC_SegField *f);
+
+/* Segmentmaske eines Zeichens (0 = leer) */
+uint8_t XHC_Seg_Mask(char c);
+
+#endif /* INC_XHC_SEG_H_ */
@@ -0,0 +1,58 @@
+/*
+ * xhc_shadow.h
+ *
+ *  Created on: Oct 18, 2026
+ *      4bpp-Schatten-Framebuffer mit Pixel-Diff und Screenshot-Auslese.
+ *      Nur aktiv mit XHC_SHADOW_FB=1 (siehe xhc_config.h).
+ */
+
+#ifndef INC_XHC_SHADOW_H_
+#define INC_XHC_SHADOW_H_
+
+#pragma once
+#include <stdint.h>
+#include "fonts.h"
+#include "xhc_config.h"
+
+#define XHC_SHADOW_W      160u
+#define XHC_SHADOW_H      128u
+#define XHC_SHADOW_BYTES  (XHC_SHADOW_W * XHC_SHADOW_H / 2u)
+
+/* Screenshot-Protokoll (Vendor-Reports, siehe usbd_custom_hid_if.c):
+   Feature 0x0A  Host -> Gerät: Screenshot anfordern
+   Input   0x0B  Gerät -> Host: [0x0B][off_lo][off_hi][n][n Bytes]
+                 off = 0xFFFF: Palette (16 x RGB565 LE), sonst Offset im
+                 4bpp-Puffer (Zeile für Zeile, gerades x im oberen Nibble) */
+#define XHC_SHOT_REQ_ID     0x0Au
+#define XHC_SHOT_DATA_ID    0x0Bu
+#define XHC_SHOT_CHUNK      60u
+#define XHC_SHOT_PALETTE    0xFFFFu
+
+void     XHC_Shadow_Init(void);
+
+/* RGB565 -> Palettenindex (fehlende Farben werden nachgetragen, bei voller
+   Palette nächstliegende Farbe) */
+uint8_t  XHC_Shadow_Index(uint16_t color);
+uint16_t XHC_Shadow_Color(uint8_t idx);
+
+/* Zeichnen in den Schatten (merkt geänderte Pixel als dirty vor) */
+void XHC_Shadow_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+void XHC_Shadow_DrawChar(int16_t x, int16_t y, char ch, FontDef font, uint16_t fg, uint16_t bg);
+void XHC_Shadow_DrawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *data);
+
+/* fertig komponiertes Index-Band übernehmen (nur echte Änderungen) */
+void XHC_Shadow_CommitBand(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t *idx);
+
+/* geänderte Spans als RGB565 per DMA zum Panel */
+void XHC_Shadow_Flush(void);
+
+/* ganzen Schatten beim nächsten Flush neu senden (z.B. nach Panel-Reset) */
+void XHC_Shadow_Invalidate(void);
+/* nur die Zeilen y..y+h-1 (Selbstheilung, siehe XHC_HEAL) */
+void XHC_Shadow_InvalidateRows(uint16_t y, uint16_t h);
+
+/* Screenshot: Anforderung merken / im Hauptloop stückweise senden */
+void XHC_Shadow_RequestScreenshot(void);
+void XHC_Shadow_ServiceScreenshot(void);
+
+#endif /* INC_XHC_SHADOW_H_ */
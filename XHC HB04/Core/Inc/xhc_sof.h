@@ -0,0 +1,45 @@
+/*
+ * xhc_sof.h
+ *
+ *  Created on: Oct 18, 2026
+ *      USB-Start-of-Frame als Taktgeber: der Host schickt jede Millisekunde
+ *      ein SOF, der IN-Poll des Interrupt-Endpoints folgt im selben Frame.
+ *      Im SOF-Interrupt werden Eingaben abgetastet und der IN-Report
+ *      bereitgelegt (XHC_Sof_Stage), die Hauptschleife rendert direkt
+ *      danach – die SPI-Bursts liegen damit im Rest des Frames.
+ */
+
+#ifndef INC_XHC_SOF_H_
+#define INC_XHC_SOF_H_
+
+#pragma once
+#include <stdint.h>
+#include "xhc_config.h"
+
+typedef struct {
+    uint32_t count;        /* SOFs seit Start */
+    uint32_t missed;       /* Lücken in der Frame-Nummer (Suspend, IRQ verschluckt) */
+    uint32_t period_min;   /* SOF-Abstand in CPU-Zyklen (48000 = 1 ms) */
+    uint32_t period_max;
+    uint32_t loop_late;    /* Hauptschleife erst nach dem nächsten SOF fertig */
+} XHC_SofStats;
+
+/* aus dem SOF-Interrupt (usbd_conf.c) */
+void XHC_Sof_Irq(void);
+
+/* schwacher Hook, läuft im SOF-Interrupt: Eingaben abtasten und den
+   nächsten IN-Report mit XHC_TX_Send bereitlegen. Kurz halten. */
+void XHC_Sof_Stage(uint16_t frame);
+
+/* 1 = SOFs kommen (konfiguriert, nicht suspendiert) */
+uint8_t XHC_Sof_Active(void);
+
+/* Hauptschleife: bis zum nächsten SOF schlafen; ohne SOFs 1 ms warten */
+void XHC_Sof_Wait(void);
+
+/* CPU-Zyklen seit dem letzten SOF */
+uint32_t XHC_Sof_Age(void);
+
+void XHC_Sof_GetStats(XHC_SofStats *out);
+
+#endif /* INC_XHC_SOF_H_ */
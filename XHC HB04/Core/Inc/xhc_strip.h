@@ -0,0 +1,50 @@
+/*
+ * xhc_strip.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Strip-Compositor: Regionen bandweise im RAM aufbauen und je Band
+ *      mit einem DMA-Transfer zum Panel schicken (kein Flackern mehr durch
+ *      "erst wischen, dann malen" direkt auf dem Display).
+ */
+
+#ifndef INC_XHC_STRIP_H_
+#define INC_XHC_STRIP_H_
+
+#pragma once
+#include <stdint.h>
+#include "fonts.h"
+
+/* Zeichnet den Inhalt einer Region. Wird einmal pro Band aufgerufen und darf
+   einfach alles zeichnen – die Primitive unten clippen auf das aktuelle Band. */
+typedef void (*XHC_StripRenderFn)(void *ctx);
+
+void XHC_Strip_Init(void);
+
+/* Region (x,y,w,h) mit Hintergrund bg bandweise rendern und ausgeben.
+   Kehrt zurück, während das letzte Band noch per DMA läuft. */
+void XHC_Strip_Render(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                      uint16_t bg, XHC_StripRenderFn fn, void *ctx);
+
+/* Zeichenprimitive – nur innerhalb eines XHC_StripRenderFn gültig.
+   Koordinaten sind Bildschirmkoordinaten. */
+void XHC_Strip_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+void XHC_Strip_DrawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+void XHC_Strip_DrawChar(int16_t x, int16_t y, char ch, FontDef font, uint16_t fg, uint16_t bg);
+void XHC_Strip_DrawString(int16_t x, int16_t y, const char *s, FontDef font, uint16_t fg, uint16_t bg);
+
+/* RLE-Palettenbild im Flash (erzeugt von tools/gen_layout_image.py).
+   Bytestrom über alle Zeilen: Farbe = b >> 4, Lauf = (b & 0x0F) + 1;
+   b & 0x0F == 0x0F: Lauf = 16 + nächstes Byte. */
+typedef struct {
+    uint16_t       w, h;
+    uint8_t        ncolors;      /* <= 16 */
+    const uint16_t *palette;     /* RGB565 */
+    const uint8_t  *data;
+    uint16_t       size;
+} XHC_RleImage;
+
+/* Bild bandweise in den Strip-Puffer entpacken und ausgeben (ohne
+   Rückruf, außerhalb eines XHC_StripRenderFn aufrufen) */
+void XHC_Strip_Image(uint16_t x, uint16_t y, const XHC_RleImage *img);
+
+#endif /* INC_XHC_STRIP_H_ */
@@ -0,0 +1,65 @@
+/*
+ * xhc_telemetry.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Binäre Laufzeit-Telemetrie: Ereignisse als Datensätze fester Größe
+ *      (8 Byte, DWT-Zeitstempel) in einen RAM-Ring, aus der Hauptschleife
+ *      in Paketen über die CDC-Schnittstelle geleert ("tel on" in der
+ *      Konsole). Schreiben ist IRQ-fest und wartet nie; ist der Ring voll,
+ *      wird gezählt und beim nächsten freien Platz ein TEL_LOST eingetragen.
+ *      Host-Decoder: tools/xhc_telemetry.py
+ *
+ *      Paket:   A5 5A n seq  n x Datensatz  xor
+ *      Datensatz (little endian): u32 Zyklen, u8 Typ, u8 a8, u16 a16
+ */
+
+#ifndef INC_XHC_TELEMETRY_H_
+#define INC_XHC_TELEMETRY_H_
+
+#pragma once
+#include <stdint.h>
+#include "xhc_config.h"
+
+typedef enum {
+    TEL_RX          = 1,   /* Report angekommen (IRQ)      a8 = Report-ID, a16 = Länge */
+    TEL_RX_DROP     = 2,   /* Report verworfen (IRQ)       a8 = Report-ID, a16 = Grund */
+    TEL_FRAME       = 3,   /* Frame-Stand neu im Cache     a8 = Art (0 Chunks, 1 ganz, 2 Delta), a16 = Feldmaske */
+    TEL_RENDER_BEG  = 4,   /* Zeichnen beginnt             a8 = Quelle (1 Live, 2 Frame) */
+    TEL_RENDER_END  = 5,   /* Zeichnen fertig              a8 = Quelle, a16 = gezeichnete Achsen (Maske) */
+    TEL_TX          = 6,   /* IN-Report übergeben          a8 = Report-ID */
+    TEL_LOST        = 7,   /* Ring war voll                a16 = verlorene Datensätze */
+} XHC_TelType;
+
+/* Gründe für TEL_RX_DROP */
+#define TEL_DROP_RING   1u   /* RX-Ring voll */
+#define TEL_DROP_MODE   2u   /* Report-ID im aktuellen Modus nicht erlaubt */
+
+typedef struct __attribute__((packed)) {
+    uint32_t cyc;
+    uint8_t  type;
+    uint8_t  a8;
+    uint16_t a16;
+} XHC_TelRecord;
+
+#if XHC_TELEMETRY
+
+/* Ereignis eintragen, aus IRQ oder Hauptschleife */
+void XHC_Tel_Log(uint8_t type, uint8_t a8, uint16_t a16);
+
+/* Hauptschleife: so viel wie in den CDC-Sendering passt abgeben */
+void XHC_Tel_Drain(void);
+
+/* Streaming an/aus (Konsole "tel on|off"); aus = XHC_Tel_Log kehrt sofort zurück */
+void    XHC_Tel_Enable(uint8_t on);
+uint8_t XHC_Tel_Enabled(void);
+
+void XHC_Tel_GetStats(uint32_t *logged, uint32_t *lost);
+
+#else
+
+static inline void XHC_Tel_Log(uint8_t type, uint8_t a8, uint16_t a16) { (void)type; (void)a8; (void)a16; }
+static inline void XHC_Tel_Drain(void) {}
+
+#endif
+
+#endif /* INC_XHC_TELEMETRY_H_ */
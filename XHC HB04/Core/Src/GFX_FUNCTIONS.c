@@ -26,6 +26,10 @@ void drawPixel(int16_t x, int16_t y, uint16_t color)
 
 void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
 {
+	// clip here, ST7735_FillRectangle takes unsigned coordinates
+	if (x < 0) { w += x; x = 0; }
+	if (y < 0) { h += y; y = 0; }
+	if (w <= 0 || h <= 0) return;
 	ST7735_FillRectangle(x, y, w, h, color);
 }
 
@@ -48,6 +52,15 @@ void writePixel(int16_t x, int16_t y, uint16_t color)
     drawPixel(x, y, color);
 }
 
+void  drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+	fillRect(x, y, 1, h, color);
+}
+void  drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+	fillRect(x, y, w, 1, color);
+}
+
 void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
 {
     int16_t steep = abs(y1 - y0) > abs(x1 - x0);
@@ -74,13 +87,18 @@ void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
         ystep = -1;
     }
 
+    // emit every stretch of pixels on the same minor coordinate as one run
+    int16_t run = x0;
     for (; x0<=x1; x0++) {
-        if (steep) {
-            writePixel(y0, x0, color);
-        } else {
-            writePixel(x0, y0, color);
-        }
         err -= dy;
+        if (err < 0 || x0 == x1) {
+            if (steep) {
+                drawFastVLine(y0, run, x0 - run + 1, color);
+            } else {
+                drawFastHLine(run, y0, x0 - run + 1, color);
+            }
+            run = x0 + 1;
+        }
         if (err < 0) {
             y0 += ystep;
             err += dx;
@@ -88,15 +106,6 @@ void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
     }
 }
 
-void  drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
-{
-	writeLine(x, y, x, y + h - 1, color);
-}
-void  drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
-{
-	writeLine(x, y, x + w - 1, y, color);
-}
-
 void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
 {
     if(x0 == x1){
@@ -110,47 +119,42 @@ void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
     }
 }
 
-void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+// One run of first-octant points (xa..xb, y) mirrored into the selected
+// quadrants: horizontal spans near the poles, vertical spans near the equator.
+static void circleRun(int16_t x0, int16_t y0, int16_t xa, int16_t xb, int16_t y, uint8_t corners, uint16_t color)
 {
-    int16_t f = 1 - r;
-    int16_t ddF_x = 1;
-    int16_t ddF_y = -2 * r;
-    int16_t x = 0;
-    int16_t y = r;
+    int16_t n = xb - xa + 1;
 
-    writePixel(x0  , y0+r, color);
-    writePixel(x0  , y0-r, color);
-    writePixel(x0+r, y0  , color);
-    writePixel(x0-r, y0  , color);
-
-    while (x<y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
-
-        writePixel(x0 + x, y0 + y, color);
-        writePixel(x0 - x, y0 + y, color);
-        writePixel(x0 + x, y0 - y, color);
-        writePixel(x0 - x, y0 - y, color);
-        writePixel(x0 + y, y0 + x, color);
-        writePixel(x0 - y, y0 + x, color);
-        writePixel(x0 + y, y0 - x, color);
-        writePixel(x0 - y, y0 - x, color);
+    if (corners & 0x4) {
+        drawFastHLine(x0 + xa, y0 + y, n, color);
+        drawFastVLine(x0 + y, y0 + xa, n, color);
+    }
+    if (corners & 0x2) {
+        drawFastHLine(x0 + xa, y0 - y, n, color);
+        drawFastVLine(x0 + y, y0 - xb, n, color);
+    }
+    if (corners & 0x8) {
+        drawFastVLine(x0 - y, y0 + xa, n, color);
+        drawFastHLine(x0 - xb, y0 + y, n, color);
+    }
+    if (corners & 0x1) {
+        drawFastVLine(x0 - y, y0 - xb, n, color);
+        drawFastHLine(x0 - xb, y0 - y, n, color);
     }
 }
 
-void drawCircleHelper( int16_t x0, int16_t y0, int16_t r, uint8_t cornername, uint16_t color)
+// Midpoint circle, same point set as the classic per-pixel version, but
+// consecutive points with equal y are collected into runs.
+static void circleOutline(int16_t x0, int16_t y0, int16_t r, uint8_t corners, uint8_t with_axes, uint16_t color)
 {
     int16_t f     = 1 - r;
     int16_t ddF_x = 1;
     int16_t ddF_y = -2 * r;
     int16_t x     = 0;
     int16_t y     = r;
+    int16_t xa    = 0;
+    int16_t ry    = r;
+    uint8_t open  = with_axes;  // x = 0 starts the first run
 
     while (x<y) {
         if (f >= 0) {
@@ -161,23 +165,28 @@ void drawCircleHelper( int16_t x0, int16_t y0, int16_t r, uint8_t cornername, ui
         x++;
         ddF_x += 2;
         f     += ddF_x;
-        if (cornername & 0x4) {
-            writePixel(x0 + x, y0 + y, color);
-            writePixel(x0 + y, y0 + x, color);
-        }
-        if (cornername & 0x2) {
-            writePixel(x0 + x, y0 - y, color);
-            writePixel(x0 + y, y0 - x, color);
-        }
-        if (cornername & 0x8) {
-            writePixel(x0 - y, y0 + x, color);
-            writePixel(x0 - x, y0 + y, color);
+
+        if (open && y != ry) {
+            circleRun(x0, y0, xa, x - 1, ry, corners, color);
+            open = 0;
         }
-        if (cornername & 0x1) {
-            writePixel(x0 - y, y0 - x, color);
-            writePixel(x0 - x, y0 - y, color);
+        if (!open) {
+            xa   = x;
+            ry   = y;
+            open = 1;
         }
     }
+    if (open) circleRun(x0, y0, xa, x, ry, corners, color);
+}
+
+void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+    circleOutline(x0, y0, r, 0xF, 1, color);
+}
+
+void drawCircleHelper( int16_t x0, int16_t y0, int16_t r, uint8_t cornername, uint16_t color)
+{
+    circleOutline(x0, y0, r, cornername, 0, color);
 }
 
 void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color)
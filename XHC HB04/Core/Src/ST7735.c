@@ -1,4 +1,7 @@
 #include <ST7735.h>
+#include <string.h>
+#include "xhc_config.h"
+#include "xhc_shadow.h"
 
 
 int16_t _width;       ///< Display width as modified by current rotation
@@ -11,13 +14,62 @@ uint8_t _rowstart;       ///< Some displays need this changed to offset
 uint8_t _xstart;
 uint8_t _ystart;
 
+static volatile bool s_dma_busy = false; ///< SPI TX DMA in flight, CS still low
+#if ST7735_SPI16
+static volatile bool s_dma_fill = false; ///< running DMA is a fill (MINC off)
+static uint16_t s_fill_word;             ///< DMA fill source
+#endif
+
+#if ST7735_QUEUE
+#if ST7735_QUEUE_DEPTH & (ST7735_QUEUE_DEPTH - 1)
+#error "ST7735_QUEUE_DEPTH must be a power of two"
+#endif
+enum { Q_CMD, Q_FILL, Q_BLIT };
+
+typedef struct {
+    uint8_t op;
+    uint8_t cmd, nargs;           // Q_CMD
+    uint8_t args[4];
+    uint8_t x0, y0, x1, y1;       // Q_FILL / Q_BLIT window
+    uint16_t color;               // Q_FILL, native RGB565
+    uint32_t n;                   // pixels still to send
+    const uint8_t *data;          // Q_BLIT source, ST7735_WIRE16 order
+} ST7735_QEntry;
+
+static ST7735_QEntry s_q[ST7735_QUEUE_DEPTH];
+static volatile uint32_t s_q_head;     ///< entries queued (written by thread)
+static volatile uint32_t s_q_tail;     ///< entries taken (written by the IRQ)
+static volatile uint32_t s_q_done;     ///< entries finished on the bus
+static ST7735_QEntry s_q_cur;          ///< entry on the DMA right now
+static uint32_t s_q_ram_ticket;        ///< last DrawImageDMA from RAM
+static ST7735_QueueStats s_q_stats;
+#if !ST7735_SPI16
+// 8-bit frames: the IRQ sends the command header by DMA as well, in pieces
+// (command byte with DC low, its arguments with DC high). Fills repeat one
+// panel row, i.e. one complete interrupt per 160 pixels.
+#define ST7735_Q_FILL_PX 160
+static uint32_t s_q_fill[ST7735_Q_FILL_PX / 2];  ///< fill pattern, wire order
+static uint16_t s_q_fill_c;                      ///< colour in s_q_fill
+static bool s_q_fill_ok = false;
+static uint8_t s_q_hdr[11];                  ///< CASET/RASET/RAMWR + arguments
+static uint8_t s_q_seg[5];                   ///< piece lengths, even = command
+static uint8_t s_q_nseg, s_q_iseg, s_q_hpos;
+#endif
+#endif
+
+// Last CASET/RASET values sent to the panel (offsets included). The
+// controller keeps them across CS cycles, so repeating them is wasted bus time.
+static uint8_t s_win_x0, s_win_x1, s_win_y0, s_win_y1;
+static bool s_win_valid = false;
+static ST7735_WindowStats s_win_stats;
+
   const uint8_t
   init_cmds1[] = {            // Init for 7735R, part 1 (red or green tab)
     15,                       // 15 commands in list:
     ST7735_SWRESET,   DELAY,  //  1: Software reset, 0 args, w/delay
-      150,                    //     150 ms delay
+      10,                     //     10 ms delay (5 ms min., panel is in sleep-in after RST)
     ST7735_SLPOUT ,   DELAY,  //  2: Out of sleep mode, 0 args, w/delay
-      255,                    //     500 ms delay
+      120,                    //     120 ms delay (supply/booster settle)
     ST7735_FRMCTR1, 3      ,  //  3: Frame rate ctrl - normal mode, 3 args:
       0x01, 0x2C, 0x2D,       //     Rate = fosc/(1x2+40) * (LINE+2C+2D)
     ST7735_FRMCTR2, 3      ,  //  4: Frame rate control - idle mode, 3 args:
@@ -45,7 +97,11 @@ uint8_t _ystart;
       0x0E,
     ST7735_INVOFF , 0      ,  // 13: Don't invert display, no args, no delay
     ST7735_COLMOD , 1      ,  // 15: set color mode, 1 arg, no delay:
+#if ST7735_RGB444
+      0x03 },                 //     12-bit color
+#else
       0x05 },                 //     16-bit color
+#endif
 
 #if (defined(ST7735_IS_128X128) || defined(ST7735_IS_160X128))
   init_cmds2[] = {            // Init for 7735R, part 2 (1.44" display)
@@ -85,20 +141,290 @@ uint8_t _ystart;
     ST7735_NORON  ,    DELAY, //  3: Normal display on, no args, w/delay
       10,                     //     10 ms delay
     ST7735_DISPON ,    DELAY, //  4: Main screen turn on, no args w/delay
-      100 };                  //     100 ms delay
+      10 };                   //     10 ms delay
+
+void ST7735_WaitDMA(void)
+{
+    while(s_dma_busy) {
+    }
+}
+
+bool ST7735_DMABusy(void)
+{
+    return s_dma_busy;
+}
+
+#if ST7735_DRIVER_LL
+// register path: BSRR writes and a polled SPI data register, no HAL state
+// machine, no timeout bookkeeping
+#define ST7735_CS_LOW()   (CS_PORT->BSRR = (uint32_t)CS_PIN << 16)
+#define ST7735_CS_HIGH()  (CS_PORT->BSRR = CS_PIN)
+#define ST7735_DC_CMD()   (DC_PORT->BSRR = (uint32_t)DC_PIN << 16)
+#define ST7735_DC_DATA()  (DC_PORT->BSRR = DC_PIN)
+
+static inline SPI_TypeDef *ST7735_SPI(void)
+{
+    SPI_TypeDef *spi = ST7735_SPI_PORT.Instance;
+    // 1-line bus: the HAL sets BIDIOE/SPE on its first transmit, do the same
+    if((spi->CR1 & (SPI_CR1_BIDIOE | SPI_CR1_SPE)) != (SPI_CR1_BIDIOE | SPI_CR1_SPE)) {
+        spi->CR1 |= SPI_CR1_BIDIOE | SPI_CR1_SPE;
+    }
+    return spi;
+}
+
+// wait until the last bit left the shift register (before DC/CS may change)
+static inline void ST7735_TXDone(SPI_TypeDef *spi)
+{
+    while(!(spi->SR & SPI_SR_TXE)) {
+    }
+    while(spi->SR & SPI_SR_BSY) {
+    }
+}
+
+static void ST7735_TX(const uint8_t *buff, size_t n)
+{
+    SPI_TypeDef *spi = ST7735_SPI();
+    while(n--) {
+        while(!(spi->SR & SPI_SR_TXE)) {
+        }
+        *(__IO uint8_t *)&spi->DR = *buff++;
+    }
+    ST7735_TXDone(spi);
+}
+
+#if ST7735_SPI16
+static void ST7735_TXPixels(const uint16_t *px, size_t n)
+{
+    SPI_TypeDef *spi = ST7735_SPI();
+    while(n--) {
+        while(!(spi->SR & SPI_SR_TXE)) {
+        }
+        spi->DR = *px++;
+    }
+    ST7735_TXDone(spi);
+}
+
+static void ST7735_TXFill(uint16_t color, uint32_t n)
+{
+    SPI_TypeDef *spi = ST7735_SPI();
+    while(n--) {
+        while(!(spi->SR & SPI_SR_TXE)) {
+        }
+        spi->DR = color;
+    }
+    ST7735_TXDone(spi);
+}
+#else
+static void ST7735_TXFill(uint16_t color, uint32_t n)
+{
+    SPI_TypeDef *spi = ST7735_SPI();
+    uint8_t hi = color >> 8, lo = color & 0xFF;
+    while(n--) {
+        while(!(spi->SR & SPI_SR_TXE)) {
+        }
+        *(__IO uint8_t *)&spi->DR = hi;
+        while(!(spi->SR & SPI_SR_TXE)) {
+        }
+        *(__IO uint8_t *)&spi->DR = lo;
+    }
+    ST7735_TXDone(spi);
+}
+#endif
+#else
+#define ST7735_CS_LOW()   HAL_GPIO_WritePin(CS_PORT, CS_PIN, GPIO_PIN_RESET)
+#define ST7735_CS_HIGH()  HAL_GPIO_WritePin(CS_PORT, CS_PIN, GPIO_PIN_SET)
+#define ST7735_DC_CMD()   HAL_GPIO_WritePin(DC_PORT, DC_PIN, GPIO_PIN_RESET)
+#define ST7735_DC_DATA()  HAL_GPIO_WritePin(DC_PORT, DC_PIN, GPIO_PIN_SET)
+
+static void ST7735_TX(const uint8_t *buff, size_t n)
+{
+    HAL_SPI_Transmit(&ST7735_SPI_PORT, (uint8_t*)buff, n, HAL_MAX_DELAY);
+}
+
+#if ST7735_SPI16
+// Init.DataSize is 16 bit here, so the HAL counts in halfwords
+static void ST7735_TXPixels(const uint16_t *px, size_t n)
+{
+    HAL_SPI_Transmit(&ST7735_SPI_PORT, (uint8_t*)px, n, HAL_MAX_DELAY);
+}
+
+static void ST7735_TXFill(uint16_t color, uint32_t n)
+{
+    uint16_t data[32];
+    for(uint32_t i = 0; i < 32 && i < n; i++) {
+        data[i] = color;
+    }
+    while(n > 0) {
+        uint32_t k = (n > 32) ? 32 : n;
+        HAL_SPI_Transmit(&ST7735_SPI_PORT, (uint8_t*)data, (uint16_t)k, HAL_MAX_DELAY);
+        n -= k;
+    }
+}
+#else
+// constant color: repeat one small pre-filled chunk instead of a HAL call
+// per pixel
+static void ST7735_TXFill(uint16_t color, uint32_t n)
+{
+    uint8_t data[2 * 32];
+    for(uint32_t i = 0; i < sizeof(data) && i < 2 * n; i += 2) {
+        data[i] = color >> 8;
+        data[i + 1] = color & 0xFF;
+    }
+    while(n > 0) {
+        uint32_t k = (n > 32) ? 32 : n;
+        HAL_SPI_Transmit(&ST7735_SPI_PORT, data, (uint16_t)(k * 2), HAL_MAX_DELAY);
+        n -= k;
+    }
+}
+#endif
+#endif
+
+#if ST7735_SPI16
+// 8-bit frames for commands, 16-bit frames for pixels. DFF may only change
+// with the SPI disabled; every transmit path has waited for BSY already.
+static void ST7735_FrameSize(bool wide)
+{
+    SPI_TypeDef *spi = ST7735_SPI_PORT.Instance;
+    if(((spi->CR1 & SPI_CR1_DFF) != 0) == wide) {
+        return;
+    }
+    spi->CR1 &= ~SPI_CR1_SPE;
+    if(wide) {
+        spi->CR1 |= SPI_CR1_DFF;
+    } else {
+        spi->CR1 &= ~SPI_CR1_DFF;
+    }
+    ST7735_SPI_PORT.Init.DataSize = wide ? SPI_DATASIZE_16BIT : SPI_DATASIZE_8BIT;
+    spi->CR1 |= SPI_CR1_BIDIOE | SPI_CR1_SPE;
+}
+#elif ST7735_RGB444
+// 12-bit pixels, two in three bytes: RRRRGGGG BBBBrrrr ggggbbbb. One RAMWR
+// stream is often split over several calls with odd pixel counts (glyph
+// rows), so half a pair may be held back until the stream ends.
+static bool s_px_half;
+static uint16_t s_px_held;
+
+static inline uint16_t ST7735_To444(uint16_t c)
+{
+    return (uint16_t)(((c >> 4) & 0xF00) | ((c >> 3) & 0x0F0) | ((c >> 1) & 0x00F));
+}
+
+static void ST7735_TXPixels(const uint16_t *px, size_t n)
+{
+    uint8_t out[48];
+    size_t o = 0;
+
+    while(n--) {
+        uint16_t c = ST7735_To444(*px++);
+        if(!s_px_half) {
+            s_px_held = c;
+            s_px_half = true;
+            continue;
+        }
+        out[o++] = s_px_held >> 4;
+        out[o++] = (uint8_t)((s_px_held << 4) | (c >> 8));
+        out[o++] = c & 0xFF;
+        s_px_half = false;
+        if(o == sizeof(out)) {
+            ST7735_TX(out, o);
+            o = 0;
+        }
+    }
+    if(o) {
+        ST7735_TX(out, o);
+    }
+}
+
+static void ST7735_TXFill444(uint16_t color, uint32_t n)
+{
+    uint16_t c = ST7735_To444(color);
+    uint8_t out[48];
+
+    if(s_px_half && n) {
+        ST7735_TXPixels(&color, 1);
+        n--;
+    }
+    for(uint32_t i = 0; i < sizeof(out); i += 3) {
+        out[i]     = c >> 4;
+        out[i + 1] = (uint8_t)((c << 4) | (c >> 8));
+        out[i + 2] = c & 0xFF;
+    }
+    for(uint32_t pairs = n / 2; pairs > 0; ) {
+        uint32_t k = (pairs > sizeof(out) / 3) ? sizeof(out) / 3 : pairs;
+        ST7735_TX(out, k * 3);
+        pairs -= k;
+    }
+    if(n & 1) {
+        s_px_held = c;
+        s_px_half = true;
+    }
+}
+
+// end of a RAMWR stream: the odd last pixel goes out padded to two bytes
+static void ST7735_PixelsEnd(void)
+{
+    if(s_px_half) {
+        uint8_t out[2] = { s_px_held >> 4, (uint8_t)(s_px_held << 4) };
+        s_px_half = false;
+        ST7735_DC_DATA();
+        ST7735_TX(out, sizeof(out));
+    }
+}
+
+// DMA source in RAM is packed in place (two halfwords -> three bytes, the
+// write position never overtakes the read position). Returns the byte count.
+static uint32_t ST7735_Pack444(uint16_t *px, uint32_t n)
+{
+    uint8_t *out = (uint8_t*)px;
+    uint32_t i, o = 0;
+
+    for(i = 0; i + 1 < n; i += 2) {
+        uint16_t a = ST7735_To444(px[i]);
+        uint16_t b = ST7735_To444(px[i + 1]);
+        out[o++] = a >> 4;
+        out[o++] = (uint8_t)((a << 4) | (b >> 8));
+        out[o++] = b & 0xFF;
+    }
+    if(i < n) {
+        uint16_t a = ST7735_To444(px[i]);
+        out[o++] = a >> 4;
+        out[o++] = (uint8_t)(a << 4);
+    }
+    return o;
+}
+
+#define ST7735_FrameSize(wide) ((void)0)
+#else
+// 8-bit frames throughout: a pixel is two bytes in memory order
+static void ST7735_TXPixels(const uint16_t *px, size_t n)
+{
+    ST7735_TX((const uint8_t*)px, n * 2);
+}
+
+#define ST7735_FrameSize(wide) ((void)0)
+#endif
 
 void ST7735_Select()
 {
-    HAL_GPIO_WritePin(CS_PORT, CS_PIN, GPIO_PIN_RESET);
+    // a running DMA blit owns the bus (and CS) until its complete callback
+#if ST7735_QUEUE
+    if(s_dma_busy) s_q_stats.drains++;
+#endif
+    ST7735_WaitDMA();
+    ST7735_CS_LOW();
 }
 
 void ST7735_Unselect()
 {
-    HAL_GPIO_WritePin(CS_PORT, CS_PIN, GPIO_PIN_SET);
+#if ST7735_RGB444
+    ST7735_PixelsEnd();
+#endif
+    ST7735_CS_HIGH();
 }
 
 void ST7735_Reset()
 {
+    s_win_valid = false;
     HAL_GPIO_WritePin(RST_PORT, RST_PIN, GPIO_PIN_RESET);
     HAL_Delay(5);
     HAL_GPIO_WritePin(RST_PORT, RST_PIN, GPIO_PIN_SET);
@@ -106,67 +432,189 @@ void ST7735_Reset()
 
   void ST7735_WriteCommand(uint8_t cmd)
   {
-    HAL_GPIO_WritePin(DC_PORT, DC_PIN, GPIO_PIN_RESET);
-    HAL_SPI_Transmit(&ST7735_SPI_PORT, &cmd, sizeof(cmd), HAL_MAX_DELAY);
+#if ST7735_RGB444
+    ST7735_PixelsEnd();
+#endif
+    ST7735_FrameSize(false);
+    ST7735_DC_CMD();
+    ST7735_TX(&cmd, sizeof(cmd));
 }
 
 void ST7735_WriteData(uint8_t* buff, size_t buff_size)
 {
-    HAL_GPIO_WritePin(DC_PORT, DC_PIN, GPIO_PIN_SET);
-    HAL_SPI_Transmit(&ST7735_SPI_PORT, buff, buff_size, HAL_MAX_DELAY);
+    ST7735_FrameSize(false);
+    ST7735_DC_DATA();
+    ST7735_TX(buff, buff_size);
 }
 
-void DisplayInit(const uint8_t *addr)
+void ST7735_WritePixels(const uint16_t* px, size_t n)
 {
-    uint8_t numCommands, numArgs;
+    ST7735_FrameSize(true);
+    ST7735_DC_DATA();
+    ST7735_TXPixels(px, n);
+}
+
+// sends the next command of an init list, returns the delay it asks for
+static uint16_t DisplayCommand(const uint8_t **paddr)
+{
+    const uint8_t *addr = *paddr;
+    uint8_t numArgs;
     uint16_t ms;
 
+    uint8_t cmd = *addr++;
+    ST7735_WriteCommand(cmd);
+
+    numArgs = *addr++;
+    // If high bit set, delay follows args
+    ms = numArgs & DELAY;
+    numArgs &= ~DELAY;
+    if(numArgs) {
+        ST7735_WriteData((uint8_t*)addr, numArgs);
+        addr += numArgs;
+    }
+
+    if(ms) {
+        ms = *addr++;
+        if(ms == 255) ms = 500;
+    }
+    *paddr = addr;
+    return ms;
+}
+
+void DisplayInit(const uint8_t *addr)
+{
+    uint8_t numCommands;
+
+    // the init lists set their own full-screen window
+    s_win_valid = false;
+
     numCommands = *addr++;
     while(numCommands--) {
-        uint8_t cmd = *addr++;
-        ST7735_WriteCommand(cmd);
-
-        numArgs = *addr++;
-        // If high bit set, delay follows args
-        ms = numArgs & DELAY;
-        numArgs &= ~DELAY;
-        if(numArgs) {
-            ST7735_WriteData((uint8_t*)addr, numArgs);
-            addr += numArgs;
-        }
-
+        uint16_t ms = DisplayCommand(&addr);
         if(ms) {
-            ms = *addr++;
-            if(ms == 255) ms = 500;
             HAL_Delay(ms);
         }
     }
 }
 
-void ST7735_SetAddressWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+// CASET/RASET (skipped when the panel has them already) and RAMWR as one
+// byte string; seg[] gets the piece lengths, command and arguments taking
+// turns. Returns the number of pieces.
+static uint8_t ST7735_WindowHeader(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1,
+                                   uint8_t *hdr, uint8_t *seg)
 {
+    uint8_t cx0 = x0 + _xstart, cx1 = x1 + _xstart;
+    uint8_t ry0 = y0 + _ystart, ry1 = y1 + _ystart;
+    uint8_t n = 0, k = 0;
+
+    s_win_stats.windows++;
+
     // column address set
-    ST7735_WriteCommand(ST7735_CASET);
-    uint8_t data[] = { 0x00, x0 + _xstart, 0x00, x1 + _xstart };
-    ST7735_WriteData(data, sizeof(data));
+    if(!s_win_valid || cx0 != s_win_x0 || cx1 != s_win_x1) {
+        hdr[n++] = ST7735_CASET;
+        hdr[n++] = 0x00; hdr[n++] = cx0; hdr[n++] = 0x00; hdr[n++] = cx1;
+        seg[k++] = 1; seg[k++] = 4;
+        s_win_x0 = cx0;
+        s_win_x1 = cx1;
+        s_win_stats.cmd_bytes += 5;
+    } else {
+        s_win_stats.cmd_bytes_saved += 5;
+    }
 
     // row address set
-    ST7735_WriteCommand(ST7735_RASET);
-    data[1] = y0 + _ystart;
-    data[3] = y1 + _ystart;
-    ST7735_WriteData(data, sizeof(data));
+    if(!s_win_valid || ry0 != s_win_y0 || ry1 != s_win_y1) {
+        hdr[n++] = ST7735_RASET;
+        hdr[n++] = 0x00; hdr[n++] = ry0; hdr[n++] = 0x00; hdr[n++] = ry1;
+        seg[k++] = 1; seg[k++] = 4;
+        s_win_y0 = ry0;
+        s_win_y1 = ry1;
+        s_win_stats.cmd_bytes += 5;
+    } else {
+        s_win_stats.cmd_bytes_saved += 5;
+    }
+    s_win_valid = true;
 
-    // write to RAM
-    ST7735_WriteCommand(ST7735_RAMWR);
+    // write to RAM (always: it rewinds the write pointer to the window start)
+    hdr[n++] = ST7735_RAMWR;
+    seg[k++] = 1;
+    s_win_stats.cmd_bytes += 1;
+    return k;
 }
 
-void ST7735_Init(uint8_t rotation)
+void ST7735_SetAddressWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+{
+    uint8_t hdr[11], seg[5];
+    uint8_t k = ST7735_WindowHeader(x0, y0, x1, y1, hdr, seg);
+    uint8_t *p = hdr;
+
+    for(uint8_t i = 0; i < k; i++) {
+        if(i & 1) {
+            ST7735_WriteData(p, seg[i]);
+        } else {
+            ST7735_WriteCommand(*p);
+        }
+        p += seg[i];
+    }
+}
+
+void ST7735_InvalidateWindow(void)
+{
+    s_win_valid = false;
+}
+
+void ST7735_RefreshConfig(void)
 {
+    uint8_t colmod = ST7735_RGB444 ? 0x03 : 0x05;
+
+    ST7735_SetRotation(rotation);
     ST7735_Select();
-    ST7735_Reset();
-    DisplayInit(init_cmds1);
-    DisplayInit(init_cmds2);
-    DisplayInit(init_cmds3);
+    ST7735_WriteCommand(ST7735_COLMOD);
+    ST7735_WriteData(&colmod, 1);
+    ST7735_Unselect();
+    ST7735_InvalidateWindow();
+}
+
+void ST7735_SetSpiPrescaler(uint32_t prescaler)
+{
+    SPI_TypeDef *spi = ST7735_SPI_PORT.Instance;
+
+    // BR may only change while SPI is disabled: let the last frame finish
+    ST7735_WaitDMA();
+    while(spi->SR & SPI_SR_BSY) {
+    }
+    spi->CR1 &= ~SPI_CR1_SPE;
+    spi->CR1 = (spi->CR1 & ~SPI_CR1_BR) | (prescaler & SPI_CR1_BR);
+    spi->CR1 |= SPI_CR1_SPE;
+    ST7735_SPI_PORT.Init.BaudRatePrescaler = prescaler & SPI_CR1_BR;
+}
+
+void ST7735_GetWindowStats(ST7735_WindowStats *st, bool reset)
+{
+    *st = s_win_stats;
+    if(reset) {
+        memset(&s_win_stats, 0, sizeof(s_win_stats));
+    }
+}
+
+// Non-blocking bring-up: the reset pulse and the init lists are walked by
+// ST7735_InitTick(), a command delay only sets when the next tick may go on.
+// Meanwhile the main loop (and USB enumeration) keeps running.
+enum { BOOT_IDLE, BOOT_RST_LOW, BOOT_RST_HIGH, BOOT_LISTS, BOOT_DONE };
+
+static const uint8_t * const s_init_lists[] = { init_cmds1, init_cmds2, init_cmds3 };
+
+static struct {
+    uint8_t state;
+    uint8_t rotation;
+    uint8_t list;           // next list in s_init_lists
+    uint8_t left;           // commands left in the current list
+    const uint8_t *p;       // next command
+    uint32_t t0;            // HAL tick the wait started
+    uint32_t wait;          // ms
+} s_boot;
+
+static void ST7735_InitFinish(uint8_t rotation)
+{
 #if ST7735_IS_160X80
     _colstart = 24;
     _rowstart = 0;
@@ -187,6 +635,83 @@ void ST7735_Init(uint8_t rotation)
     ST7735_SetRotation (rotation);
     ST7735_Unselect();
 
+#if ST7735_SPI16
+    // pixel DMA moves halfwords; CCR may be changed while the channel is off
+    DMA_HandleTypeDef *dma = ST7735_SPI_PORT.hdmatx;
+    if(dma) {
+        dma->Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+        dma->Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+        dma->Instance->CCR = (dma->Instance->CCR & ~(DMA_CCR_PSIZE | DMA_CCR_MSIZE))
+                           | DMA_PDATAALIGN_HALFWORD | DMA_MDATAALIGN_HALFWORD;
+    }
+#endif
+}
+
+void ST7735_InitStart(uint8_t rotation)
+{
+    s_boot.rotation = rotation;
+    s_boot.list = 0;
+    s_boot.left = 0;
+    s_win_valid = false;
+
+    HAL_GPIO_WritePin(RST_PORT, RST_PIN, GPIO_PIN_RESET);
+    s_boot.state = BOOT_RST_LOW;
+    s_boot.t0 = HAL_GetTick();
+    s_boot.wait = ST7735_RESET_MS;
+}
+
+bool ST7735_InitTick(void)
+{
+    if(s_boot.state == BOOT_DONE) return true;
+    if(s_boot.state == BOOT_IDLE) return false;
+    if((HAL_GetTick() - s_boot.t0) < s_boot.wait) return false;
+
+    switch(s_boot.state) {
+    case BOOT_RST_LOW:
+        HAL_GPIO_WritePin(RST_PORT, RST_PIN, GPIO_PIN_SET);
+        s_boot.state = BOOT_RST_HIGH;
+        s_boot.t0 = HAL_GetTick();
+        s_boot.wait = ST7735_RESET_MS;
+        return false;
+
+    case BOOT_RST_HIGH:
+        s_boot.state = BOOT_LISTS;
+        // fall through
+    default:
+        break;
+    }
+
+    // commands without delay back to back, stop at the first one with delay
+    ST7735_Select();
+    for(;;) {
+        if(s_boot.left == 0) {
+            if(s_boot.list == sizeof(s_init_lists) / sizeof(s_init_lists[0])) {
+                ST7735_Unselect();
+                ST7735_InitFinish(s_boot.rotation);
+                s_boot.state = BOOT_DONE;
+                return true;
+            }
+            s_boot.p = s_init_lists[s_boot.list++];
+            s_boot.left = *s_boot.p++;
+            continue;
+        }
+        uint16_t ms = DisplayCommand(&s_boot.p);
+        s_boot.left--;
+        if(ms) {
+            s_boot.t0 = HAL_GetTick();
+            s_boot.wait = ms;
+            break;
+        }
+    }
+    ST7735_Unselect();
+    return false;
+}
+
+void ST7735_Init(uint8_t rotation)
+{
+    ST7735_InitStart(rotation);
+    while(!ST7735_InitTick()) {
+    }
 }
 
 void ST7735_SetRotation(uint8_t m)
@@ -253,36 +778,78 @@ void ST7735_DrawPixel(uint16_t x, uint16_t y, uint16_t color) {
     if((x >= _width) || (y >= _height))
         return;
 
+#if XHC_SHADOW_FB
+    XHC_Shadow_FillRect(x, y, 1, 1, color);
+    return;
+#endif
+
     ST7735_Select();
 
-    ST7735_SetAddressWindow(x, y, x+1, y+1);
-    uint8_t data[] = { color >> 8, color & 0xFF };
-    ST7735_WriteData(data, sizeof(data));
+    // 1x1 window: a run of pixels on one row keeps RASET cached
+    ST7735_SetAddressWindow(x, y, x, y);
+    uint16_t px = ST7735_WIRE16(color);
+    ST7735_WritePixels(&px, 1);
 
     ST7735_Unselect();
 }
 
 void ST7735_WriteChar(uint16_t x, uint16_t y, char ch, FontDef font, uint16_t color, uint16_t bgcolor) {
-    uint32_t i, b, j;
+    const uint8_t *g = Font_Glyph(&font, ch);
+    const uint16_t fg = ST7735_WIRE16(color), bg = ST7735_WIRE16(bgcolor);
+    uint8_t m = 0x80;
+    uint16_t line[16];
+    uint32_t i, j;
 
     ST7735_SetAddressWindow(x, y, x+font.width-1, y+font.height-1);
 
+    // one SPI transfer per glyph row instead of one per pixel
     for(i = 0; i < font.height; i++) {
-        b = font.data[(ch - 32) * font.height + i];
         for(j = 0; j < font.width; j++) {
-            if((b << j) & 0x8000)  {
-                uint8_t data[] = { color >> 8, color & 0xFF };
-                ST7735_WriteData(data, sizeof(data));
-            } else {
-                uint8_t data[] = { bgcolor >> 8, bgcolor & 0xFF };
-                ST7735_WriteData(data, sizeof(data));
+            line[j] = (*g & m) ? fg : bg;
+            if(!(m >>= 1)) { m = 0x80; g++; }
+        }
+        ST7735_WritePixels(line, font.width);
+    }
+}
+
+// n glyphs side by side through a single window: row i of every glyph, then
+// row i+1, so CASET/RASET/RAMWR go out once per run instead of once per glyph
+static void ST7735_WriteRun(uint16_t x, uint16_t y, const char* str, uint16_t n, FontDef font, uint16_t color, uint16_t bgcolor) {
+    const uint8_t *g[ST7735_MAX_RUN];
+    const uint16_t fg = ST7735_WIRE16(color), bg = ST7735_WIRE16(bgcolor);
+    uint16_t line[32];
+    uint32_t i, j, k, p = 0;
+
+    for(k = 0; k < n; k++) {
+        g[k] = Font_Glyph(&font, str[k]);
+    }
+
+    ST7735_SetAddressWindow(x, y, x+n*font.width-1, y+font.height-1);
+
+    for(i = 0; i < font.height; i++) {
+        uint32_t bit = i * font.width;
+        for(k = 0; k < n; k++) {
+            const uint8_t *b = g[k] + (bit >> 3);
+            uint8_t m = 0x80 >> (bit & 7);
+            for(j = 0; j < font.width; j++) {
+                line[p++] = (*b & m) ? fg : bg;
+                if(p == 32) {
+                    ST7735_WritePixels(line, p);
+                    p = 0;
+                }
+                if(!(m >>= 1)) { m = 0x80; b++; }
             }
         }
     }
+    if(p) {
+        ST7735_WritePixels(line, p);
+    }
 }
 
 void ST7735_WriteString(uint16_t x, uint16_t y, const char* str, FontDef font, uint16_t color, uint16_t bgcolor) {
+#if !XHC_SHADOW_FB
     ST7735_Select();
+#endif
 
     while(*str) {
         if(x + font.width >= _width) {
@@ -299,30 +866,133 @@ void ST7735_WriteString(uint16_t x, uint16_t y, const char* str, FontDef font, u
             }
         }
 
-        ST7735_WriteChar(x, y, *str, font, color, bgcolor);
+#if XHC_SHADOW_FB
+        XHC_Shadow_DrawChar(x, y, *str, font, color, bgcolor);
         x += font.width;
         str++;
+#else
+        // as many glyphs as fit before the line would wrap
+        uint16_t n = 1;
+        while(n < ST7735_MAX_RUN && str[n] && x + (n + 1) * font.width < _width) {
+            n++;
+        }
+        ST7735_WriteRun(x, y, str, n, font, color, bgcolor);
+        x += n * font.width;
+        str += n;
+#endif
+    }
+
+#if !XHC_SHADOW_FB
+    ST7735_Unselect();
+#endif
+}
+
+void ST7735_WriteStringDirect(uint16_t x, uint16_t y, const char* str, FontDef font, uint16_t color, uint16_t bgcolor) {
+    if(y + font.height > _height) return;
+
+    ST7735_Select();
+    while(*str && x + font.width <= _width) {
+        uint16_t n = 1;
+        while(n < ST7735_MAX_RUN && str[n] && x + (n + 1) * font.width <= _width) {
+            n++;
+        }
+        ST7735_WriteRun(x, y, str, n, font, color, bgcolor);
+        x += n * font.width;
+        str += n;
+    }
+    ST7735_Unselect();
+}
+
+static void ST7735_Command16(uint8_t cmd, const uint16_t *args, uint8_t n)
+{
+    uint8_t data[6];
+    for(uint8_t i = 0; i < n; i++) {
+        data[2*i]   = args[i] >> 8;
+        data[2*i+1] = args[i] & 0xFF;
     }
+    ST7735_Select();
+    ST7735_WriteCommand(cmd);
+    ST7735_WriteData(data, 2*n);
+    ST7735_Unselect();
+}
+
+void ST7735_SetScrollArea(uint16_t top, uint16_t height)
+{
+    uint16_t a[3];
+    a[0] = top + _ystart;                              // TFA
+    a[1] = height;                                     // VSA
+    a[2] = (a[0] + a[1] < ST7735_GRAM_ROWS) ?          // BFA
+           ST7735_GRAM_ROWS - a[0] - a[1] : 0;
+    ST7735_Command16(ST7735_VSCRDEF, a, 3);
+}
+
+void ST7735_SetScrollStart(uint16_t row)
+{
+    uint16_t ssa = row + _ystart;
+    ST7735_Command16(ST7735_VSCSAD, &ssa, 1);
+}
 
+void ST7735_ScrollOff(void)
+{
+    ST7735_SetScrollArea(0, ST7735_GRAM_ROWS - _ystart);
+    ST7735_SetScrollStart(0);
+    ST7735_Select();
+    ST7735_WriteCommand(ST7735_NORON);
     ST7735_Unselect();
 }
 
 void ST7735_FillRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+#if XHC_SHADOW_FB
+    if((x >= _width) || (y >= _height)) return;
+    if((x + w - 1) >= _width) w = _width - x;
+    if((y + h - 1) >= _height) h = _height - y;
+    XHC_Shadow_FillRect(x, y, w, h, color);
+#else
+    ST7735_FillRectangleDirect(x, y, w, h, color);
+#endif
+}
+
+void ST7735_FillRectangleDirect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
 {
     if((x >= _width) || (y >= _height)) return;
     if((x + w - 1) >= _width) w = _width - x;
     if((y + h - 1) >= _height) h = _height - y;
 
+#if ST7735_QUEUE
+    if(ST7735_SPI_PORT.hdmatx) {
+        ST7735_QueueFill(x, y, w, h, color);
+        return;
+    }
+#endif
+
     ST7735_Select();
     ST7735_SetAddressWindow(x, y, x+w-1, y+h-1);
+    ST7735_FrameSize(true);
+    ST7735_DC_DATA();
 
-    uint8_t data[] = { color >> 8, color & 0xFF };
-    HAL_GPIO_WritePin(DC_PORT, DC_PIN, GPIO_PIN_SET);
-    for(y = h; y > 0; y--) {
-        for(x = w; x > 0; x--) {
-            HAL_SPI_Transmit(&ST7735_SPI_PORT, data, sizeof(data), HAL_MAX_DELAY);
+#if ST7735_SPI16
+    // larger areas: let the DMA repeat one halfword (no memory increment)
+    // and return right away; CS is released from the complete callback
+    if((uint32_t)w * h >= ST7735_DMA_FILL_MIN && ST7735_SPI_PORT.hdmatx) {
+        DMA_Channel_TypeDef *ch = ST7735_SPI_PORT.hdmatx->Instance;
+        s_fill_word = color;
+        ch->CCR &= ~DMA_CCR_MINC;
+        s_dma_fill = true;
+        s_dma_busy = true;
+        if(HAL_SPI_Transmit_DMA(&ST7735_SPI_PORT, (uint8_t*)&s_fill_word, (uint16_t)(w * h)) == HAL_OK) {
+            return;
         }
+        s_dma_busy = false;
+        s_dma_fill = false;
+        ch->CCR |= DMA_CCR_MINC;
     }
+#endif
+#if ST7735_RGB444
+    ST7735_TXFill444(color, (uint32_t)w * h);
+#else
+    ST7735_TXFill(color, (uint32_t)w * h);
+#endif
 
     ST7735_Unselect();
 }
@@ -332,12 +1002,316 @@ void ST7735_DrawImage(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint
     if((x + w - 1) >= _width) return;
     if((y + h - 1) >= _height) return;
 
+#if XHC_SHADOW_FB
+    XHC_Shadow_DrawImage(x, y, w, h, data);
+    return;
+#endif
+
     ST7735_Select();
     ST7735_SetAddressWindow(x, y, x+w-1, y+h-1);
-    ST7735_WriteData((uint8_t*)data, sizeof(uint16_t)*w*h);
+    ST7735_WritePixels(data, (size_t)w*h);
     ST7735_Unselect();
 }
 
+void ST7735_DrawImageDMA(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t* data) {
+    if((x >= _width) || (y >= _height)) return;
+    if((x + w - 1) >= _width) return;
+    if((y + h - 1) >= _height) return;
+
+#if ST7735_QUEUE
+    if(ST7735_SPI_PORT.hdmatx) {
+        // RAM sources are double-buffered by the callers: the previous one
+        // has to be on the panel before its buffer comes back
+        if(((uint32_t)data & 0xE0000000u) == 0x20000000u) {
+            while(!ST7735_QueueDone(s_q_ram_ticket)) {
+            }
+            s_q_ram_ticket = ST7735_QueueBlit(x, y, w, h, data);
+        } else {
+            ST7735_QueueBlit(x, y, w, h, data);
+        }
+        return;
+    }
+#endif
+
+    ST7735_Select();
+    ST7735_SetAddressWindow(x, y, x+w-1, y+h-1);
+    ST7735_FrameSize(true);
+    ST7735_DC_DATA();
+
+    // the HAL counts frames: pixels with 16-bit frames, bytes with 8-bit
+    uint16_t frames = ST7735_SPI16 ? (uint16_t)(w*h) : (uint16_t)(w*h*2u);
+#if ST7735_RGB444
+    // RAM buffers are packed in place right before the transfer; flash
+    // data (sprites) cannot be, it takes the blocking packer instead
+    if(((uint32_t)data & 0xE0000000u) != 0x20000000u) {
+        ST7735_TXPixels((const uint16_t*)data, (size_t)w*h);
+        ST7735_Unselect();
+        return;
+    }
+    frames = (uint16_t)ST7735_Pack444((uint16_t*)data, (uint32_t)w*h);
+#endif
+    s_dma_busy = true;
+    if(HAL_SPI_Transmit_DMA(&ST7735_SPI_PORT, (uint8_t*)data, frames) != HAL_OK) {
+        // DMA not available: fall back to the blocking path
+        s_dma_busy = false;
+#if ST7735_RGB444
+        ST7735_TX(data, frames);
+#else
+        ST7735_TXPixels((const uint16_t*)data, (size_t)w*h);
+#endif
+        ST7735_Unselect();
+    }
+}
+
+#if ST7735_QUEUE
+// Next DMA chunk of s_q_cur (window, DC and CS are already set). The HAL
+// counts at most 65535 frames, 8-bit fills repeat a one-row pattern.
+static bool ST7735_QueueDMA(void)
+{
+    ST7735_QEntry *e = &s_q_cur;
+    const uint8_t *src;
+    uint32_t px;
+
+    if(e->op == Q_FILL) {
+#if ST7735_SPI16
+        px = (e->n > 0xFFFF) ? 0xFFFF : e->n;
+        s_fill_word = e->color;
+        ST7735_SPI_PORT.hdmatx->Instance->CCR &= ~DMA_CCR_MINC;
+        s_dma_fill = true;
+        src = (const uint8_t*)&s_fill_word;
+#else
+        px = (e->n > ST7735_Q_FILL_PX) ? ST7735_Q_FILL_PX : e->n;
+        src = (const uint8_t*)s_q_fill;
+#endif
+    } else {
+        px = (e->n > 0x7FFF) ? 0x7FFF : e->n;
+        src = e->data;
+        e->data += px * 2;
+    }
+    e->n -= px;
+
+    if(HAL_SPI_Transmit_DMA(&ST7735_SPI_PORT, (uint8_t*)src,
+                            (uint16_t)(ST7735_SPI16 ? px : px * 2)) == HAL_OK) {
+        return true;
+    }
+    // DMA refused: finish this entry on the CPU
+#if ST7735_SPI16
+    if(s_dma_fill) {
+        ST7735_SPI_PORT.hdmatx->Instance->CCR |= DMA_CCR_MINC;
+        s_dma_fill = false;
+    }
+#endif
+    if(e->op == Q_FILL) {
+        ST7735_TXFill(e->color, px + e->n);
+    } else {
+        ST7735_TXPixels((const uint16_t*)src, px + e->n);
+    }
+    e->n = 0;
+    return false;
+}
+
+#if !ST7735_SPI16
+// Next piece of the command header on the DMA; false once all of it is out.
+// The complete callback comes after BSY dropped, so DC may switch here.
+static bool ST7735_QueueHeader(void)
+{
+    while(s_q_iseg < s_q_nseg) {
+        uint8_t i = s_q_iseg++;
+        uint8_t *p = &s_q_hdr[s_q_hpos];
+
+        s_q_hpos += s_q_seg[i];
+        if(i & 1) {
+            ST7735_DC_DATA();
+        } else {
+            ST7735_DC_CMD();
+        }
+        if(HAL_SPI_Transmit_DMA(&ST7735_SPI_PORT, p, s_q_seg[i]) == HAL_OK) {
+            return true;
+        }
+        // DMA refused: this piece on the CPU, try the next one again
+        ST7735_TX(p, s_q_seg[i]);
+    }
+    return false;
+}
+#endif
+
+// Works through the queue until an entry is on the DMA. Runs in the
+// complete interrupt, or in thread context to kick an idle queue (nothing
+// touches the queue after the DMA start). With 8-bit frames the header
+// goes out by DMA too; with ST7735_SPI16 the channel is halfword wide, so
+// commands and window are still sent blocking from here.
+static void ST7735_QueueRun(void)
+{
+    while(s_q_tail != s_q_head) {
+        s_q_cur = s_q[s_q_tail & (ST7735_QUEUE_DEPTH - 1)];
+        s_q_tail++;
+
+        ST7735_CS_LOW();
+#if ST7735_SPI16
+        if(s_q_cur.op == Q_CMD) {
+            ST7735_WriteCommand(s_q_cur.cmd);
+            if(s_q_cur.nargs) {
+                ST7735_WriteData(s_q_cur.args, s_q_cur.nargs);
+            }
+        } else {
+            ST7735_SetAddressWindow(s_q_cur.x0, s_q_cur.y0, s_q_cur.x1, s_q_cur.y1);
+            ST7735_FrameSize(true);
+            ST7735_DC_DATA();
+            if(ST7735_QueueDMA()) {
+                return;
+            }
+        }
+#else
+        if(s_q_cur.op == Q_CMD) {
+            s_q_hdr[0] = s_q_cur.cmd;
+            memcpy(&s_q_hdr[1], s_q_cur.args, s_q_cur.nargs);
+            s_q_seg[0] = 1;
+            s_q_seg[1] = s_q_cur.nargs;
+            s_q_nseg = s_q_cur.nargs ? 2 : 1;
+        } else {
+            s_q_nseg = ST7735_WindowHeader(s_q_cur.x0, s_q_cur.y0,
+                                           s_q_cur.x1, s_q_cur.y1, s_q_hdr, s_q_seg);
+            if(s_q_cur.op == Q_FILL && (!s_q_fill_ok || s_q_fill_c != s_q_cur.color)) {
+                uint32_t c = ST7735_WIRE16(s_q_cur.color);
+                c |= c << 16;
+                for(uint32_t i = 0; i < ST7735_Q_FILL_PX / 2; i++) {
+                    s_q_fill[i] = c;
+                }
+                s_q_fill_c = s_q_cur.color;
+                s_q_fill_ok = true;
+            }
+        }
+        s_q_iseg = 0;
+        s_q_hpos = 0;
+        if(ST7735_QueueHeader()) {
+            return;
+        }
+        if(s_q_cur.n) {
+            ST7735_DC_DATA();
+            if(ST7735_QueueDMA()) {
+                return;
+            }
+        }
+#endif
+        ST7735_CS_HIGH();
+        s_q_done++;
+    }
+    s_dma_busy = false;
+}
+
+// free slot for the caller to fill, waits while the queue is full
+static ST7735_QEntry *ST7735_QueueSlot(void)
+{
+    if(s_q_head - s_q_tail >= ST7735_QUEUE_DEPTH) {
+        s_q_stats.stalls++;
+        while(s_q_head - s_q_tail >= ST7735_QUEUE_DEPTH) {
+        }
+    }
+    return &s_q[s_q_head & (ST7735_QUEUE_DEPTH - 1)];
+}
+
+// publishes the filled slot, starts the queue when it was idle
+static uint32_t ST7735_QueuePush(void)
+{
+    bool kick;
+    uint32_t ticket;
+
+    __disable_irq();
+    ticket = ++s_q_head;
+    kick = !s_dma_busy;
+    if(kick) s_dma_busy = true;
+    __enable_irq();
+
+    uint16_t depth = (uint16_t)(ticket - s_q_tail);
+    if(depth > s_q_stats.max_depth) s_q_stats.max_depth = depth;
+    s_q_stats.entries++;
+
+    if(kick) ST7735_QueueRun();
+    return ticket;
+}
+
+uint32_t ST7735_QueueCommand(uint8_t cmd, const uint8_t *args, uint8_t n)
+{
+    ST7735_QEntry *e = ST7735_QueueSlot();
+    if(n > sizeof(e->args)) n = sizeof(e->args);
+    e->op = Q_CMD;
+    e->cmd = cmd;
+    e->nargs = n;
+    e->n = 0;
+    memcpy(e->args, args, n);
+    return ST7735_QueuePush();
+}
+
+uint32_t ST7735_QueueFill(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    ST7735_QEntry *e = ST7735_QueueSlot();
+    e->op = Q_FILL;
+    e->x0 = x; e->y0 = y; e->x1 = x+w-1; e->y1 = y+h-1;
+    e->color = color;
+    e->n = (uint32_t)w * h;
+    return ST7735_QueuePush();
+}
+
+uint32_t ST7735_QueueBlit(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t* data)
+{
+    ST7735_QEntry *e = ST7735_QueueSlot();
+    e->op = Q_BLIT;
+    e->x0 = x; e->y0 = y; e->x1 = x+w-1; e->y1 = y+h-1;
+    e->n = (uint32_t)w * h;
+    e->data = data;
+    return ST7735_QueuePush();
+}
+
+bool ST7735_QueueDone(uint32_t ticket)
+{
+    return (int32_t)(s_q_done - ticket) >= 0;
+}
+
+void ST7735_GetQueueStats(ST7735_QueueStats *st, bool reset)
+{
+    if(st) {
+        *st = s_q_stats;
+        st->depth = (uint16_t)(s_q_head - s_q_tail);
+    }
+    if(reset) {
+        memset(&s_q_stats, 0, sizeof(s_q_stats));
+    }
+}
+#endif
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    // HAL only calls this after BSY dropped, so CS can go high right away
+    if(hspi == &ST7735_SPI_PORT && s_dma_busy) {
+#if ST7735_SPI16
+        if(s_dma_fill) {
+            hspi->hdmatx->Instance->CCR |= DMA_CCR_MINC;
+            s_dma_fill = false;
+        }
+#endif
+#if ST7735_QUEUE
+        // rest of the header, then the pixels, then the next entry
+#if !ST7735_SPI16
+        if(ST7735_QueueHeader()) {
+            return;
+        }
+        if(s_q_cur.n) {
+            ST7735_DC_DATA();
+        }
+#endif
+        if(s_q_cur.n && ST7735_QueueDMA()) {
+            return;
+        }
+        ST7735_CS_HIGH();
+        s_q_done++;
+        ST7735_QueueRun();
+        return;
+#endif
+        ST7735_Unselect();
+        s_dma_busy = false;
+    }
+}
+
 void ST7735_InvertColors(bool invert) {
     ST7735_Select();
     ST7735_WriteCommand(invert ? ST7735_INVON : ST7735_INVOFF);
@@ -28,6 +28,14 @@
 #include "xhc_display.h"
 #include "ST7735.h"
 #include "GFX_FUNCTIONS.h"
+#include "xhc_shadow.h"
+#include "xhc_bench.h"
+#include "xhc_boot.h"
+#include "xhc_sof.h"
+#include "xhc_console.h"
+#include "xhc_telemetry.h"
+#include "usbd_def.h"
+#include "xhc_config.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -47,6 +55,7 @@
 
 /* Private variables ---------------------------------------------------------*/
 SPI_HandleTypeDef hspi1;
+DMA_HandleTypeDef hdma_spi1_tx;
 
 /* USER CODE BEGIN PV */
 
@@ -55,6 +64,7 @@ SPI_HandleTypeDef hspi1;
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
+static void MX_DMA_Init(void);
 static void MX_SPI1_Init(void);
 /* USER CODE BEGIN PFP */
 void insert_thousand_separators(char *s);
@@ -71,6 +81,65 @@ void int2strprec( int32_t v, char padd, char *o );
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
+extern USBD_HandleTypeDef hUsbDeviceFS;
+
+/* Display-Bring-up läuft schrittweise im Hauptloop (USB zählt derweil im
+   Interrupt auf); danach statisches Layout in Bändern per DMA */
+static uint8_t s_lcd_ready = 0;
+
+static void Boot_Tick(void)
+{
+  static uint8_t s_usb_marked;
+  if (!s_usb_marked && hUsbDeviceFS.dev_state == USBD_STATE_CONFIGURED){
+    s_usb_marked = 1;
+    XHC_Boot_Mark("usb");
+  }
+
+  if (s_lcd_ready || !ST7735_InitTick()) return;
+  s_lcd_ready = 1;
+  XHC_Boot_Mark("lcd");
+
+  XHC_Shadow_Init();
+#if XHC_BENCH
+  XHC_Bench_Primitives();
+#endif
+  XHC_Display_Init();
+  RenderScreen_Init();
+  XHC_Boot_Mark("layout");
+}
+
+#if XHC_USB_LOG
+/* ohne Host: Scroll-Log mit den USB-Zuständen statt eingefrorener DRO */
+static uint8_t  s_usb_state = 0xFF;
+static uint8_t  s_usb_log;          /* Log von hier geöffnet */
+static uint32_t s_usb_seen_t;       /* zuletzt konfiguriert gesehen */
+
+static void Usb_Log_Tick(void)
+{
+  static const char *const names[] = { "usb -", "usb default", "usb addressed",
+                                       "usb configured", "usb suspended" };
+  uint8_t  st  = hUsbDeviceFS.dev_state;
+  uint32_t now = HAL_GetTick();
+  const char *name = names[st < 5u ? st : 0u];
+
+  if (s_usb_state == 0xFF) s_usb_seen_t = now;       /* Frist ab LCD bereit */
+  else if (st != s_usb_state) XHC_Display_Log(name);  /* ohne Log: nichts */
+  s_usb_state = st;
+
+  if (st == USBD_STATE_CONFIGURED){
+    s_usb_seen_t = now;
+    if (s_usb_log){
+      s_usb_log = 0;
+      XHC_Display_LogEnd();
+      RenderScreen_Restore();
+    }
+  } else if (!s_usb_log && !XHC_Display_LogActive() && (now - s_usb_seen_t) >= XHC_USB_LOG_MS){
+    s_usb_log = 1;
+    XHC_Display_LogBegin("USB: kein Host");
+    XHC_Display_Log(name);
+  }
+}
+#endif
 
 /* USER CODE END 0 */
 
@@ -91,6 +160,7 @@ int main(void)
   HAL_Init();
 
   /* USER CODE BEGIN Init */
+  XHC_Boot_Start();
 
   /* USER CODE END Init */
 
@@ -98,18 +168,17 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
+  XHC_Boot_ClockChanged();
 
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_SPI1_Init();
   MX_USB_DEVICE_Init();
   /* USER CODE BEGIN 2 */
-  ST7735_Init(3);
-  fillScreen(WHITE);
-  XHC_Display_Init();
-  RenderScreen_Init();
+  ST7735_InitStart(3);        /* weiter in Boot_Tick() */
   //testAll();
   /* USER CODE END 2 */
 
@@ -117,8 +186,14 @@ int main(void)
   /* USER CODE BEGIN WHILE */
   while (1)
   {
-	    RenderScreen();     // <— nur noch ein Aufruf
-	    HAL_Delay(1);
+	    Boot_Tick();
+#if XHC_USB_LOG
+	    if (s_lcd_ready) Usb_Log_Tick();
+#endif
+	    if (s_lcd_ready) RenderScreen();     // <— nur noch ein Aufruf
+	    XHC_Console_Poll();                  // CDC-Konsole (XHC_USB_CDC)
+	    XHC_Tel_Drain();                     // Telemetrie über CDC (XHC_TELEMETRY)
+	    XHC_Sof_Wait();                      // bis zum nächsten USB-Frame
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
@@ -210,6 +285,22 @@ static void MX_SPI1_Init(void)
 
 }
 
+/**
+  * Enable DMA controller clock
+  */
+static void MX_DMA_Init(void)
+{
+
+  /* DMA controller clock enable */
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  /* DMA interrupt init */
+  /* DMA1_Channel3_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Channel3_IRQn, 1, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+
+}
+
 /**
   * @brief GPIO Initialization Function
   * @param None
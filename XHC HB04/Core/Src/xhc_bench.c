@@ -0,0 +1,80 @@
+/*
+ * xhc_bench.c
+ *
+ *  Created on: Oct 18, 2026
+ *      DWT-Zyklenzähler und Benchmark der Zeichenprimitive
+ */
+
+#include <stdio.h>
+#include "xhc_bench.h"
+#include "ST7735.h"
+#include "GFX_FUNCTIONS.h"
+#include "xhc_digits.h"
+#include "xhc_shadow.h"
+
+void XHC_Bench_Init(void)
+{
+    /* nur einschalten, nicht nullen: Boot-Timeline und Schätzer
+       rechnen mit Differenzen ab einem früheren Stand */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/* ==== Testfälle: was ein UI-Update typischerweise anstößt ==== */
+static void b_pixels(void)   { for (uint16_t x = 0; x < 160u; ++x) ST7735_DrawPixel(x, 20, BLACK); }
+static void b_fill(void)     { ST7735_FillRectangle(0, 0, 160, 16, BLUE); }
+static void b_text13(void)   { ST7735_WriteString(0, 20, "12345.6789", Font_13x13, BLACK, WHITE); }
+static void b_text7(void)    { ST7735_WriteString(0, 40, "F 100% S 100% 1.000", Font_7x10, BLACK, WHITE); }
+static void b_image(void)    { ST7735_DrawImage(0, 60, XHC_DIGIT_W, XHC_DIGIT_H, XHC_Digit_Sprite('8')); }
+static void b_image_dma(void){ ST7735_DrawImageDMA(0, 60, XHC_DIGIT_W, XHC_DIGIT_H,
+                                                   (const uint8_t*)XHC_Digit_Sprite('8'));
+                               ST7735_WaitDMA(); }
+static void b_line(void)     { drawLine(0, 0, 159, 127, RED); }
+static void b_circle(void)   { drawCircle(80, 64, 40, GREEN); }
+static void b_fcircle(void)  { fillCircle(80, 64, 30, CYAN); }
+static void b_ftri(void)     { fillTriangle(10, 120, 80, 10, 150, 120, YELLOW); }
+static void b_screen(void)   { fillScreen(WHITE); }
+
+typedef struct {
+    const char *name;
+    void (*fn)(void);
+} bench_case_t;
+
+static const bench_case_t s_cases[] = {
+    { "pixel x160", b_pixels    },
+    { "fill 160x16", b_fill     },
+    { "text 13x13", b_text13    },
+    { "text 7x10", b_text7      },
+    { "image 7x13", b_image     },
+    { "dma 7x13",  b_image_dma  },
+    { "line",      b_line       },
+    { "circle r40", b_circle    },
+    { "fcircle r30", b_fcircle  },
+    { "ftriangle", b_ftri       },
+    { "screen",    b_screen     },
+};
+#define BENCH_CASES  (sizeof(s_cases) / sizeof(s_cases[0]))
+
+void XHC_Bench_Primitives(void)
+{
+    uint32_t cyc[BENCH_CASES];
+
+    for (uint8_t i = 0; i < BENCH_CASES; ++i){
+        uint32_t t0 = XHC_Bench_Cycles();
+        s_cases[i].fn();
+        XHC_Shadow_Flush();          /* im Schattenbetrieb gehört der Flush dazu */
+        cyc[i] = XHC_Bench_Cycles() - t0;
+    }
+
+    /* Tabelle: Name + kCycles, Kopfzeile zeigt die Treibervariante */
+    char line[28];
+    ST7735_WriteString(0, 0, ST7735_DRIVER_LL ? "bench LL  kcyc" : "bench HAL kcyc",
+                       Font_7x10, BLUE, WHITE);
+    for (uint8_t i = 0; i < BENCH_CASES; ++i){
+        snprintf(line, sizeof(line), "%-11s %7lu", s_cases[i].name,
+                 (unsigned long)((cyc[i] + 500u) / 1000u));
+        ST7735_WriteString(0, (uint16_t)(10u + i * 10u), line, Font_7x10, BLACK, WHITE);
+    }
+    XHC_Shadow_Flush();
+    HAL_Delay(XHC_BENCH_HOLD_MS);
+}
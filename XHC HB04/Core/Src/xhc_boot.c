@@ -0,0 +1,56 @@
+/*
+ * xhc_boot.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Boot-Timeline (siehe xhc_boot.h)
+ */
+
+#include <string.h>
+#include "xhc_boot.h"
+#include "xhc_bench.h"
+
+static XHC_BootMark s_marks[XHC_BOOT_MAX_MARKS];
+static uint8_t      s_count;
+static uint32_t     s_t0;      /* Zählerstand der letzten Taktumstellung */
+static uint32_t     s_us0;     /* bis dahin vergangene µs */
+static uint32_t     s_mhz;     /* Kerntakt seit s_t0 */
+
+void XHC_Boot_Start(void)
+{
+    XHC_Bench_Init();
+    s_t0  = XHC_Bench_Cycles();
+    s_us0 = 0;
+    s_mhz = SystemCoreClock / 1000000u;   /* HSI, 8 MHz */
+    s_count = 0;
+    XHC_Boot_Mark("hal");
+}
+
+void XHC_Boot_ClockChanged(void)
+{
+    /* bisherige Zyklen mit dem alten Takt abrechnen, dann neu aufsetzen */
+    uint32_t now = XHC_Bench_Cycles();
+    s_us0 += (now - s_t0) / s_mhz;
+    s_t0   = now;
+    s_mhz  = SystemCoreClock / 1000000u;
+    XHC_Boot_Mark("clock");
+}
+
+void XHC_Boot_Mark(const char *tag)
+{
+    for (uint8_t i = 0; i < s_count; ++i){
+        if (strcmp(s_marks[i].tag, tag) == 0) return;
+    }
+    if (s_count >= XHC_BOOT_MAX_MARKS) return;
+
+    /* Zyklen -> µs mit dem Takt seit der letzten Umstellung */
+    uint32_t cyc = XHC_Bench_Cycles() - s_t0;
+    s_marks[s_count].tag = tag;
+    s_marks[s_count].us  = s_us0 + cyc / s_mhz;
+    ++s_count;
+}
+
+const XHC_BootMark *XHC_Boot_Trace(uint8_t *count)
+{
+    if (count) *count = s_count;
+    return s_marks;
+}
@@ -0,0 +1,405 @@
+/*
+ * xhc_console.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Befehlskonsole über CDC-ACM (siehe xhc_console.h)
+ */
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "xhc_console.h"
+#include "xhc_format.h"
+
+#if XHC_USB_CDC
+
+#include "usbd_cdc_acm.h"
+#include "usbd_custom_hid_if.h"
+#include "ST7735.h"
+#include "xhc_screen.h"
+#include "xhc_display.h"
+#include "xhc_boot.h"
+#include "xhc_sof.h"
+#include "xhc_telemetry.h"
+#include "xhc_estim.h"
+#include "xhc_proto.h"
+#include "stm32f1xx_hal.h"
+
+#define LINE_MAX  40u
+#define LOG_POLL_MS  500u     /* Zähler für die Log-Seite so oft vergleichen */
+
+static char    s_line[LINE_MAX];
+static uint8_t s_len;
+
+/* Mini-printf für Konsole und Log: %s %c %u %d %lu %ld %%, Flags '-'
+   (linksbündig) und '0', Breite. Zahlen über uint2str (xhc_format),
+   newlibs vfprintf bleibt aus dem Konsolenpfad. Kürzt auf size - 1. */
+static uint16_t Con_Format(char *buf, uint16_t size, const char *fmt, va_list ap)
+{
+    uint16_t n = 0;
+    while (*fmt && n + 1u < size){
+        char c = *fmt++;
+        if (c != '%'){ buf[n++] = c; continue; }
+
+        uint8_t left = 0, width = 0, lng = 0;
+        char pad = ' ';
+        if (*fmt == '-'){ left = 1; ++fmt; }
+        if (*fmt == '0'){ pad = '0'; ++fmt; }
+        while (*fmt >= '0' && *fmt <= '9') width = (uint8_t)(width * 10u + (uint8_t)(*fmt++ - '0'));
+        if (*fmt == 'l'){ lng = 1; ++fmt; }
+
+        char num[12];
+        const char *s = num;
+        uint16_t len;
+        switch (*fmt++){
+        case 's': s = va_arg(ap, const char *); len = (uint16_t)strlen(s); break;
+        case 'c': num[0] = (char)va_arg(ap, int); len = 1u; break;
+        case '%': num[0] = '%'; len = 1u; break;
+        case 'u': {
+            uint32_t v = lng ? (uint32_t)va_arg(ap, unsigned long) : va_arg(ap, unsigned);
+            len = uint2str(v, 0u, ' ', num);
+        } break;
+        case 'd': {
+            int32_t v = lng ? (int32_t)va_arg(ap, long) : va_arg(ap, int);
+            uint32_t a = (v < 0) ? (uint32_t)0 - (uint32_t)v : (uint32_t)v;
+            len = 0u;
+            if (v < 0) num[len++] = '-';
+            len = (uint16_t)(len + uint2str(a, 0u, ' ', &num[len]));
+        } break;
+        default: buf[n] = 0; return n;      /* unbekannt: hier abbrechen */
+        }
+
+        if (pad == '0' && *s == '-' && n + 1u < size){ buf[n++] = '-'; ++s; --len; if (width) --width; }
+        uint16_t fill = (width > len) ? (uint16_t)(width - len) : 0u;
+        if (!left) while (fill && n + 1u < size){ buf[n++] = pad; --fill; }
+        while (len-- && n + 1u < size) buf[n++] = *s++;
+        while (fill && n + 1u < size){ buf[n++] = ' '; --fill; }
+    }
+    buf[n] = 0;
+    return n;
+}
+
+void XHC_Console_Printf(const char *fmt, ...)
+{
+    char buf[96];
+    va_list ap;
+    va_start(ap, fmt);
+    uint16_t n = Con_Format(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    if (n) XHC_CDC_Write(buf, n);
+}
+
+/* ===================== Befehle ===================== */
+
+/* Befehle, die zeichnen oder das SPI umstellen, erst nach der Panel-Init:
+   ST7735_InitTick schickt bis dahin noch Befehle aus dem Hauptloop */
+static uint8_t Display_Ready(void)
+{
+    if (XHC_Display_Ready()) return 1;
+    XHC_Console_Printf("display not ready\r\n");
+    return 0;
+}
+
+static void Cmd_Help(const char *arg)
+{
+    (void)arg;
+    XHC_Console_Printf("stats        RX/Frames, SOF, SPI, Queue\r\n");
+    XHC_Console_Printf("boot         Boot-Timeline ab HAL_Init\r\n");
+    XHC_Console_Printf("rate [ms]    Rate-Limit je Quelle\r\n");
+    XHC_Console_Printf("spi [2..256] SPI-Vorteiler (48 MHz / n)\r\n");
+    XHC_Console_Printf("axes [3..6]  angezeigte Achsen\r\n");
+    XHC_Console_Printf("zoom [-1..n] Layout: -1 = alle Werte, sonst Feld groß\r\n");
+    XHC_Console_Printf("restore      Anzeige neu aufbauen\r\n");
+    XHC_Console_Printf("log [off|..] Ereignis-Log am Panel, Text = eigene Zeile\r\n");
+#if XHC_PROTO == XHC_PROTO_WHB04B4 || XHC_PROTO == XHC_PROTO_WHB04B6
+    XHC_Console_Printf("group [xyz|abc] Achsgruppe der WHB04B-Zeilen\r\n");
+#endif
+#if XHC_ESTIMATOR
+    XHC_Console_Printf("motion       Geschwindigkeit/Beschleunigung je Achse\r\n");
+#endif
+#if XHC_TELEMETRY
+    XHC_Console_Printf("tel [on|off] Binär-Telemetrie (tools/xhc_telemetry.py)\r\n");
+#endif
+}
+
+static void Cmd_Stats(const char *arg)
+{
+    (void)arg;
+    XHC_Console_Printf("rx %lu queued, %lu dropped, mode %u\r\n",
+                       (unsigned long)XHC_RX_Count(), (unsigned long)XHC_RX_Dropped(),
+                       (unsigned)XHC_Mode());
+
+    XHC_SofStats sof;
+    XHC_Sof_GetStats(&sof);
+    XHC_Console_Printf("sof %lu, missed %lu, period %lu..%lu cyc, late loops %lu\r\n",
+                       (unsigned long)sof.count, (unsigned long)sof.missed,
+                       (unsigned long)(sof.count > 1u ? sof.period_min : 0u),
+                       (unsigned long)sof.period_max, (unsigned long)sof.loop_late);
+
+    ST7735_WindowStats win;
+    ST7735_GetWindowStats(&win, false);
+    XHC_Console_Printf("win %lu, cmd bytes %lu, saved %lu\r\n",
+                       (unsigned long)win.windows, (unsigned long)win.cmd_bytes,
+                       (unsigned long)win.cmd_bytes_saved);
+
+#if ST7735_QUEUE
+    ST7735_QueueStats q;
+    ST7735_GetQueueStats(&q, false);
+    XHC_Console_Printf("queue %lu entries, %lu stalls, %lu drains, depth %u/%u\r\n",
+                       (unsigned long)q.entries, (unsigned long)q.stalls,
+                       (unsigned long)q.drains, q.depth, q.max_depth);
+#endif
+
+    XHC_Console_Printf("cdc dropped tx %lu rx %lu\r\n",
+                       (unsigned long)XHC_CDC_TxDropped(), (unsigned long)XHC_CDC_RxDropped());
+}
+
+static void Cmd_Boot(const char *arg)
+{
+    (void)arg;
+    uint8_t n;
+    const XHC_BootMark *m = XHC_Boot_Trace(&n);
+    XHC_Console_Printf("us ab HAL_Init (ohne Reset/Startup)\r\n");
+    for (uint8_t i = 0; i < n; ++i){
+        XHC_Console_Printf("%-7s %8lu us\r\n", m[i].tag, (unsigned long)m[i].us);
+    }
+}
+
+static void Cmd_Rate(const char *arg)
+{
+    if (*arg) RenderScreen_SetRateLimit((uint16_t)strtoul(arg, NULL, 10));
+    XHC_Console_Printf("rate %u ms\r\n", RenderScreen_RateLimit());
+}
+
+static void Cmd_Spi(const char *arg)
+{
+    /* Vorteiler 2^(BR+1), BR steht in CR1 ab Bit 3 */
+    static const uint32_t br[8] = {
+        SPI_BAUDRATEPRESCALER_2,  SPI_BAUDRATEPRESCALER_4,  SPI_BAUDRATEPRESCALER_8,
+        SPI_BAUDRATEPRESCALER_16, SPI_BAUDRATEPRESCALER_32, SPI_BAUDRATEPRESCALER_64,
+        SPI_BAUDRATEPRESCALER_128, SPI_BAUDRATEPRESCALER_256
+    };
+    if (*arg){
+        if (!Display_Ready()) return;
+        uint32_t div = strtoul(arg, NULL, 10);
+        uint8_t i = 0;
+        while (i < 7u && (2u << i) < div) ++i;
+        ST7735_SetSpiPrescaler(br[i]);
+    }
+    uint32_t div = 2u << ((ST7735_SPI_PORT.Init.BaudRatePrescaler & SPI_CR1_BR) >> SPI_CR1_BR_Pos);
+    /* SPI1 hängt an APB2 = HCLK */
+    XHC_Console_Printf("spi /%lu = %lu kHz\r\n", (unsigned long)div,
+                       (unsigned long)(HAL_RCC_GetPCLK2Freq() / div / 1000u));
+}
+
+static void Cmd_Zoom(const char *arg)
+{
+    if (*arg){
+        if (!Display_Ready()) return;
+        RenderScreen_SetZoom((int8_t)strtol(arg, NULL, 10));
+        XHC_Console_Printf("ok\r\n");
+    }
+}
+
+static void Cmd_Axes(const char *arg)
+{
+    if (*arg){
+        if (!Display_Ready()) return;
+        RenderScreen_SetAxes((uint8_t)strtoul(arg, NULL, 10));
+    }
+    XHC_Console_Printf("axes %u\r\n", (unsigned)RenderScreen_Axes());
+}
+
+static void Cmd_Restore(const char *arg)
+{
+    (void)arg;
+    if (!Display_Ready()) return;
+    RenderScreen_Restore();
+    XHC_Console_Printf("ok\r\n");
+}
+
+/* ---- Log-Seite: Zählerstände beim Öffnen, danach nur Änderungen ---- */
+static uint32_t s_log_t, s_log_rxd, s_log_miss, s_log_late;
+static uint8_t  s_log_mode;
+
+static void Log_Printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+static void Log_Printf(const char *fmt, ...)
+{
+    char buf[24];
+    va_list ap;
+    va_start(ap, fmt);
+    Con_Format(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    XHC_Display_Log(buf);
+}
+
+static void Log_Tick(void)
+{
+    uint32_t now = HAL_GetTick();
+    if (!XHC_Display_LogActive() || (now - s_log_t) < LOG_POLL_MS) return;
+    s_log_t = now;
+
+    XHC_SofStats sof;
+    XHC_Sof_GetStats(&sof);
+    uint32_t rxd = XHC_RX_Dropped();
+    uint8_t mode = XHC_Mode();
+
+    if (rxd != s_log_rxd)            Log_Printf("rx drop +%lu", (unsigned long)(rxd - s_log_rxd));
+    if (sof.missed != s_log_miss)    Log_Printf("sof miss +%lu", (unsigned long)(sof.missed - s_log_miss));
+    if (sof.loop_late != s_log_late) Log_Printf("late +%lu", (unsigned long)(sof.loop_late - s_log_late));
+    if (mode != s_log_mode)          Log_Printf("mode %u", (unsigned)mode);
+    s_log_rxd = rxd; s_log_miss = sof.missed; s_log_late = sof.loop_late; s_log_mode = mode;
+}
+
+static void Log_Open(void)
+{
+    uint8_t n;
+    const XHC_BootMark *m = XHC_Boot_Trace(&n);
+    XHC_SofStats sof;
+    XHC_Sof_GetStats(&sof);
+
+    XHC_Display_LogBegin("XHC Log");
+    if (n) Log_Printf("boot %lu ms", (unsigned long)(m[n - 1u].us / 1000u));
+    Log_Printf("rx %lu drop %lu", (unsigned long)XHC_RX_Count(), (unsigned long)XHC_RX_Dropped());
+    Log_Printf("sof %lu miss %lu", (unsigned long)sof.count, (unsigned long)sof.missed);
+    Log_Printf("mode %u", (unsigned)XHC_Mode());
+
+    s_log_t = HAL_GetTick();
+    s_log_rxd = XHC_RX_Dropped(); s_log_miss = sof.missed; s_log_late = sof.loop_late;
+    s_log_mode = XHC_Mode();
+}
+
+/* "log" öffnet die Seite, "log off" schließt sie, sonst Text als Zeile */
+static void Cmd_Log(const char *arg)
+{
+    if (!Display_Ready()) return;
+    if (strcmp(arg, "off") == 0){
+        if (XHC_Display_LogActive()){
+            XHC_Display_LogEnd();
+            RenderScreen_Restore();
+        }
+    } else if (!*arg || strcmp(arg, "on") == 0){
+        if (!XHC_Display_LogActive()) Log_Open();
+    } else {
+        if (!XHC_Display_LogActive()) Log_Open();
+        XHC_Display_Log(arg);
+    }
+    XHC_Console_Printf("log %s\r\n", XHC_Display_LogActive() ? "on" : "off");
+}
+
+#if XHC_PROTO == XHC_PROTO_WHB04B4 || XHC_PROTO == XHC_PROTO_WHB04B6
+static void Cmd_Group(const char *arg)
+{
+    if (strcmp(arg, "xyz") == 0) XHC_Proto_SetAxisGroup(0u);
+    if (strcmp(arg, "abc") == 0) XHC_Proto_SetAxisGroup(1u);
+    XHC_Console_Printf("group %s\r\n", XHC_Proto_AxisGroup() ? "abc" : "xyz");
+}
+#endif
+
+#if XHC_ESTIMATOR
+static void Cmd_Motion(const char *arg)
+{
+    (void)arg;
+    static const char axis[6] = { 'X', 'Y', 'Z', 'A', 'B', 'C' };
+    const XHC_Motion *m = XHC_Est_Motion();
+    /* Einheiten: 1/10000 je s bzw. s² -> je min bzw. je s² */
+    for (uint8_t i = 0; i < RenderScreen_Axes(); ++i){
+        XHC_Console_Printf("%c v %ld/min a %ld/s2\r\n", axis[i],
+                           (long)m->vel[i] * 3 / 500, (long)(m->acc[i] / 10000));
+    }
+    uint32_t dtg = XHC_Est_DistToGo();
+    XHC_Console_Printf("bahn %lu/min a %ld/s2 dtg %lu.%04lu\r\n",
+                       (unsigned long)XHC_Est_FeedPerMin(), (long)(m->path_acc / 10000),
+                       (unsigned long)(dtg / 10000u), (unsigned long)(dtg % 10000u));
+}
+#endif
+
+#if XHC_TELEMETRY
+static void Cmd_Tel(const char *arg)
+{
+    if (strcmp(arg, "on") == 0)  XHC_Tel_Enable(1u);
+    if (strcmp(arg, "off") == 0) XHC_Tel_Enable(0u);
+
+    uint32_t logged, lost;
+    XHC_Tel_GetStats(&logged, &lost);
+    XHC_Console_Printf("tel %s, %lu logged, %lu lost\r\n", XHC_Tel_Enabled() ? "on" : "off",
+                       (unsigned long)logged, (unsigned long)lost);
+}
+#endif
+
+typedef struct {
+    const char *name;
+    void (*fn)(const char *arg);
+} XHC_ConsoleCmd;
+
+static const XHC_ConsoleCmd s_cmds[] = {
+    { "help",    Cmd_Help    },
+    { "stats",   Cmd_Stats   },
+    { "boot",    Cmd_Boot    },
+    { "rate",    Cmd_Rate    },
+    { "spi",     Cmd_Spi     },
+    { "axes",    Cmd_Axes    },
+    { "zoom",    Cmd_Zoom    },
+    { "restore", Cmd_Restore },
+    { "log",     Cmd_Log     },
+#if XHC_PROTO == XHC_PROTO_WHB04B4 || XHC_PROTO == XHC_PROTO_WHB04B6
+    { "group",   Cmd_Group   },
+#endif
+#if XHC_ESTIMATOR
+    { "motion",  Cmd_Motion  },
+#endif
+#if XHC_TELEMETRY
+    { "tel",     Cmd_Tel     },
+#endif
+};
+
+static void Console_Exec(char *line)
+{
+    char *arg = strchr(line, ' ');
+    if (arg){
+        *arg++ = 0;
+        while (*arg == ' ') ++arg;
+    } else {
+        arg = line + strlen(line);
+    }
+    if (!*line) return;
+
+    for (uint8_t i = 0; i < sizeof(s_cmds) / sizeof(s_cmds[0]); ++i){
+        if (strcmp(line, s_cmds[i].name) == 0){
+            s_cmds[i].fn(arg);
+            return;
+        }
+    }
+    XHC_Console_Printf("? %s (help)\r\n", line);
+}
+
+void XHC_Console_Poll(void)
+{
+    uint8_t c;
+    Log_Tick();
+    while (XHC_CDC_Read(&c, 1u)){
+        if (c == '\r' || c == '\n'){
+            if (!s_len) continue;
+            s_line[s_len] = 0;
+            s_len = 0;
+            XHC_Console_Printf("\r\n");
+            Console_Exec(s_line);
+            return;                   /* eine Zeile je Durchlauf */
+        }
+        if (c == 0x08u || c == 0x7Fu){
+            if (s_len){ --s_len; XHC_CDC_Write("\b \b", 3u); }
+            continue;
+        }
+        if (s_len < LINE_MAX - 1u && c >= ' '){
+            s_line[s_len++] = (char)c;
+            XHC_CDC_Write(&c, 1u);    /* Echo */
+        }
+    }
+}
+
+#else
+
+void XHC_Console_Poll(void) {}
+void XHC_Console_Printf(const char *fmt, ...) { (void)fmt; }
+
+#endif /* XHC_USB_CDC */
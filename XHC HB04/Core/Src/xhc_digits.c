@@ -0,0 +1,248 @@
+/*
+ * xhc_digits.c
+ *
+ *  ERZEUGT von tools/gen_digit_sprites.py – nicht von Hand ändern.
+ *      Font_13x13, Zeichen " #-.0123456789", Zellen 7x13, schwarz auf weiß
+ */
+
+#include "xhc_digits.h"
+
+#define X XHC_DIGIT_PX(XHC_DIGIT_FG)
+#define _ XHC_DIGIT_PX(XHC_DIGIT_BG)
+
+static const uint16_t s_sprites[XHC_DIGIT_COUNT][XHC_DIGIT_W * XHC_DIGIT_H] = {
+    /* ' ' */ {
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+    },
+    /* '#' */ {
+        _,_,_,_,_,_,_,
+        _,_,_,X,_,_,X,
+        _,_,_,X,_,X,X,
+        _,X,X,X,X,X,X,
+        _,_,X,X,_,X,_,
+        _,_,X,X,_,X,_,
+        _,X,X,X,X,X,X,
+        _,_,X,_,X,X,_,
+        _,_,X,_,X,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+    },
+    /* '-' */ {
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,X,X,X,X,_,_,
+        _,X,X,X,X,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+    },
+    /* '.' */ {
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,X,X,_,_,_,
+        _,_,X,X,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+    },
+    /* '0' */ {
+        _,_,_,_,_,_,_,
+        _,_,_,X,X,_,_,
+        _,_,X,X,X,X,X,
+        _,_,X,_,_,X,X,
+        _,X,X,_,_,X,X,
+        _,X,X,_,_,_,X,
+        _,X,X,_,_,_,X,
+        _,X,X,_,_,X,X,
+        _,_,X,_,_,X,X,
+        _,_,X,X,X,X,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+    },
+    /* '1' */ {
+        _,_,_,_,_,_,_,
+        _,_,_,_,X,X,_,
+        _,_,_,_,X,X,_,
+        _,_,X,X,X,X,_,
+        _,_,_,_,X,X,_,
+        _,_,_,_,X,X,_,
+        _,_,_,_,X,X,_,
+        _,_,_,_,X,X,_,
+        _,_,_,_,X,X,_,
+        _,_,_,_,X,X,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+    },
+    /* '2' */ {
+        _,_,_,_,_,_,_,
+        _,_,_,X,X,_,_,
+        _,_,X,X,X,X,X,
+        _,_,X,_,_,X,X,
+        _,_,_,_,_,X,X,
+        _,_,_,_,_,X,X,
+        _,_,_,_,X,X,_,
+        _,_,X,X,_,_,_,
+        _,_,X,X,X,X,X,
+        _,X,X,X,X,X,X,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+    },
+    /* '3' */ {
+        _,_,_,_,_,_,_,
+        _,_,_,X,X,_,_,
+        _,_,X,X,X,X,X,
+        _,X,X,_,_,X,X,
+        _,_,_,_,_,X,X,
+        _,_,_,_,X,X,_,
+        _,_,_,_,_,X,X,
+        _,X,X,_,_,_,X,
+        _,X,X,_,_,X,X,
+        _,_,X,X,X,X,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+    },
+    /* '4' */ {
+        _,_,_,_,_,_,_,
+        _,_,_,_,X,X,_,
+        _,_,_,_,X,X,_,
+        _,_,_,X,_,X,_,
+        _,_,_,X,_,X,_,
+        _,_,X,_,_,X,_,
+        _,X,X,_,_,X,_,
+        _,X,X,X,X,X,X,
+        _,_,_,_,_,X,_,
+        _,_,_,_,_,X,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+    },
+    /* '5' */ {
+        _,_,_,_,_,_,_,
+        _,_,X,X,X,X,X,
+        _,_,X,X,X,X,X,
+        _,_,X,_,_,_,_,
+        _,_,X,_,X,X,_,
+        _,_,X,X,X,X,X,
+        _,_,_,_,_,X,X,
+        _,_,_,_,_,_,X,
+        _,X,X,_,_,X,X,
+        _,_,X,X,X,X,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+    },
+    /* '6' */ {
+        _,_,_,_,_,_,_,
+        _,_,_,X,X,X,_,
+        _,_,X,X,X,X,X,
+        _,_,X,_,_,_,_,
+        _,X,X,_,X,X,_,
+        _,X,X,X,X,X,X,
+        _,X,X,_,_,X,X,
+        _,X,X,_,_,_,X,
+        _,_,X,_,_,X,X,
+        _,_,X,X,X,X,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+    },
+    /* '7' */ {
+        _,_,_,_,_,_,_,
+        _,X,X,X,X,X,X,
+        _,X,X,X,X,X,X,
+        _,_,_,_,_,X,X,
+        _,_,_,_,X,X,_,
+        _,_,_,_,X,X,_,
+        _,_,_,X,X,_,_,
+        _,_,_,X,X,_,_,
+        _,_,_,X,_,_,_,
+        _,_,_,X,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+    },
+    /* '8' */ {
+        _,_,_,_,_,_,_,
+        _,_,_,X,X,_,_,
+        _,_,X,X,X,X,X,
+        _,_,X,_,_,_,X,
+        _,_,X,_,_,X,X,
+        _,_,X,X,X,X,_,
+        _,X,X,_,_,X,X,
+        _,X,X,_,_,_,X,
+        _,X,X,_,_,X,X,
+        _,_,X,X,X,X,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+    },
+    /* '9' */ {
+        _,_,_,_,_,_,_,
+        _,_,_,X,X,_,_,
+        _,_,X,X,X,X,_,
+        _,X,X,_,_,X,X,
+        _,X,X,_,_,X,X,
+        _,_,X,_,_,X,X,
+        _,_,X,X,X,_,X,
+        _,_,_,_,_,X,X,
+        _,_,X,_,_,X,X,
+        _,_,X,X,X,X,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+        _,_,_,_,_,_,_,
+    },
+};
+
+#undef X
+#undef _
+
+const uint16_t* XHC_Digit_Sprite(char c)
+{
+    switch (c){
+    case ' ': return s_sprites[0];
+    case '#': return s_sprites[1];
+    case '-': return s_sprites[2];
+    case '.': return s_sprites[3];
+    case '0': return s_sprites[4];
+    case '1': return s_sprites[5];
+    case '2': return s_sprites[6];
+    case '3': return s_sprites[7];
+    case '4': return s_sprites[8];
+    case '5': return s_sprites[9];
+    case '6': return s_sprites[10];
+    case '7': return s_sprites[11];
+    case '8': return s_sprites[12];
+    case '9': return s_sprites[13];
+    default:  return 0;
+    }
+}
@@ -8,6 +8,7 @@
 #include "xhc_display.h"
 #include "ST7735.h"
 #include "fonts.h"
+#include "xhc_shadow.h"
 #include <string.h>
 
 #ifndef WHITE
@@ -24,6 +25,21 @@
 
 static char    s_last[XHC_ROWS][MAX_COLS];
 static uint8_t s_len[XHC_ROWS];
+static uint8_t s_ready;         // Panel-Init durch, XHC_Display_Init gelaufen
+
+/* Scroll-Log: Rotation 2 (Hochformat, MY=0 -> Bildschirmzeile = GRAM-Zeile) */
+#define LOG_ROTATION  2
+#define LOG_W       128
+#define LOG_TOP     LINE_H                       // Titelzeile fest
+#define LOG_H       (XHC_LOG_ROWS * LINE_H)      // 144 Zeilen scrollen
+#define LOG_COLS    (LOG_W / CHAR_W)             // 18
+
+extern uint8_t rotation;
+
+static uint8_t s_log_on;
+static uint8_t s_log_rot;      // Rotation vor dem Log
+static uint8_t s_log_count;    // belegte Zeilen
+static uint8_t s_log_head;     // Slot der ältesten Zeile (oben sichtbar)
 
 static void put_char(uint16_t x, uint16_t y, char c)
 {
@@ -42,19 +58,31 @@ static void draw_line_diff(uint8_t row, const char* text)
     uint16_t y = (uint16_t)(row * LINE_H);
     for (size_t i=0; i<maxlen; ++i){
         char nc = (i < len)    ? text[i]          : ' ';
+#if XHC_SHADOW_FB
+        /* Schattenpuffer vergleicht pixelgenau, Zeichen-Cache unnötig */
+        put_char((uint16_t)(i*CHAR_W), y, nc);
+#else
         char oc = (i < oldlen) ? s_last[row][i]   : ' ';
         if (nc != oc){
             put_char((uint16_t)(i*CHAR_W), y, nc);
         }
+#endif
     }
     memcpy(s_last[row], text, len);
     s_len[row] = (uint8_t)len;
+    XHC_Shadow_Flush();
 }
 
 void XHC_Display_Init(void)
 {
     memset(s_last, 0, sizeof(s_last));
     memset(s_len,  0, sizeof(s_len));
+    s_ready = 1;
+}
+
+uint8_t XHC_Display_Ready(void)
+{
+    return s_ready;
 }
 
 void XHC_Display_SetHeader(const char *text) { draw_line_diff(0, text); }
@@ -64,3 +92,72 @@ void XHC_Display_SetLine(uint8_t line_idx, const char *text)
     if (line_idx < 1 || line_idx > 6) return;
     draw_line_diff(line_idx, text);
 }
+
+void XHC_Display_LogBegin(const char *title)
+{
+    char t[LOG_COLS + 1];
+
+    if (!s_log_on){
+        s_log_rot = rotation;
+        s_log_on  = 1;
+    }
+    ST7735_WaitDMA();
+    ST7735_SetRotation(LOG_ROTATION);
+    ST7735_InvalidateWindow();
+
+    ST7735_FillRectangleDirect(0, 0, LOG_W, ST7735_HEIGHT, WHITE);
+    ST7735_FillRectangleDirect(0, 0, LOG_W, LOG_TOP, BLACK);
+    strncpy(t, title ? title : "", LOG_COLS);
+    t[LOG_COLS] = 0;
+    ST7735_WriteStringDirect(0, 1, t, Font_7x10, WHITE, BLACK);
+
+    ST7735_SetScrollArea(LOG_TOP, LOG_H);
+    ST7735_SetScrollStart(LOG_TOP);
+    s_log_count = 0;
+    s_log_head  = 0;
+}
+
+void XHC_Display_Log(const char *text)
+{
+    char t[LOG_COLS + 1];
+    uint8_t slot;
+
+    if (!s_log_on) return;
+
+    if (s_log_count < XHC_LOG_ROWS){
+        slot = s_log_count++;
+    } else {
+        /* älteste Zeile nach unten rollen, dann überschreiben */
+        slot = s_log_head;
+        s_log_head = (uint8_t)((s_log_head + 1u) % XHC_LOG_ROWS);
+        ST7735_SetScrollStart((uint16_t)(LOG_TOP + s_log_head * LINE_H));
+    }
+
+    /* immer volle Breite, damit Reste der alten Zeile verschwinden */
+    size_t len = strlen(text);
+    if (len > LOG_COLS) len = LOG_COLS;
+    memcpy(t, text, len);
+    memset(t + len, ' ', LOG_COLS - len);
+    t[LOG_COLS] = 0;
+    ST7735_WriteStringDirect(0, (uint16_t)(LOG_TOP + slot * LINE_H), t, Font_7x10, BLACK, WHITE);
+}
+
+void XHC_Display_LogEnd(void)
+{
+    if (!s_log_on) return;
+    s_log_on = 0;
+
+    ST7735_WaitDMA();
+    ST7735_ScrollOff();
+    ST7735_SetRotation(s_log_rot);
+    ST7735_InvalidateWindow();
+
+    /* Panelinhalt passt nicht mehr zu den Caches */
+    XHC_Display_Init();
+    XHC_Shadow_Invalidate();
+}
+
+uint8_t XHC_Display_LogActive(void)
+{
+    return s_log_on;
+}
@@ -0,0 +1,172 @@
+/*
+ * xhc_estim.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Alpha-Beta-Bewegungsschätzer (siehe xhc_estim.h)
+ */
+
+#include <string.h>
+#include "xhc_estim.h"
+
+#if XHC_ESTIMATOR
+
+#include "stm32f1xx_hal.h"   /* SystemCoreClock */
+
+#define EST_MIN_DT_US   1000u    /* dichter liegende Frames: erst mit dem nächsten rechnen */
+#define EST_ACC_K       64       /* Glättung der Beschleunigung, Q8 (1/4 je Frame) */
+#define EST_STILL       2u       /* so viele gleiche Positionen = Stillstand */
+#define EST_DTG_MIN_ACC 10000    /* erst ab 1 mm/s² Verzögerung gilt als Bremsen */
+
+static XHC_Motion s_m;
+static int32_t    s_v_q8[XHC_AXES];    /* Geschwindigkeit Q8, Einheiten/s */
+static int32_t    s_last_z[XHC_AXES];
+static uint8_t    s_same[XHC_AXES];    /* Frames ohne Positionsänderung */
+static uint32_t   s_cyc;
+static uint32_t   s_frame_cyc;         /* letzter Frame, auch wenn nicht gerechnet */
+static uint8_t    s_init;
+
+/* Wurzel ohne Division, 64 Bit rein, 32 Bit raus */
+static uint32_t isqrt64(uint64_t n)
+{
+    uint64_t r = 0, b = (uint64_t)1 << 62;
+    while (b > n) b >>= 2;
+    while (b){
+        if (n >= r + b){ n -= r + b; r = (r >> 1) + b; }
+        else r >>= 1;
+        b >>= 2;
+    }
+    return (uint32_t)r;
+}
+
+static inline int32_t iabs32(int32_t v) { return (v < 0) ? -v : v; }
+
+/* Zwischenwerte auf +-2^30 begrenzen: kurzes dt mit großem Residuum
+   darf nicht überlaufen */
+static inline int32_t sat30(int64_t v)
+{
+    if (v >  (1 << 30)) return  (1 << 30);
+    if (v < -(1 << 30)) return -(1 << 30);
+    return (int32_t)v;
+}
+
+static void Est_ResetAxis(uint8_t i, int32_t z)
+{
+    s_m.pos[i] = z; s_m.vel[i] = 0; s_m.acc[i] = 0;
+    s_v_q8[i] = 0; s_last_z[i] = z; s_same[i] = 0;
+}
+
+void XHC_Est_Reset(void)
+{
+    memset(&s_m, 0, sizeof(s_m));
+    memset(s_v_q8, 0, sizeof(s_v_q8));
+    s_init = 0;
+}
+
+void XHC_Est_Update(const int32_t pos[XHC_AXES], uint32_t cyc)
+{
+    uint32_t dt_us = (cyc - s_cyc) / (SystemCoreClock / 1000000u);
+    s_frame_cyc = cyc;
+
+    if (!s_init || dt_us > XHC_EST_GAP_MS * 1000u){
+        for (uint8_t i = 0; i < XHC_AXES; ++i) Est_ResetAxis(i, pos[i]);
+        s_m.speed = 0; s_m.path_acc = 0; s_m.moving = 0;
+        s_cyc = cyc; s_init = 1;
+        return;
+    }
+    if (dt_us < EST_MIN_DT_US) return;   /* Positionen sind absolut, nichts geht verloren */
+    s_cyc = cyc;
+
+    /* dt in s Q16 (<= 0.5 s -> <= 32768) und 1/dt in Q14, einmal je Frame */
+    uint32_t dt_q16 = (dt_us * 4295u) >> 16;
+    int32_t  inv_dt = (int32_t)((1u << 30) / dt_q16);
+
+    uint8_t moving = 0;
+    for (uint8_t i = 0; i < XHC_AXES; ++i){
+        int32_t z = pos[i];
+
+        /* Stillstand: Position steht -> exakt übernehmen, v = 0 */
+        if (z == s_last_z[i]){
+            if (s_same[i] < EST_STILL) ++s_same[i];
+            if (s_same[i] >= EST_STILL){ Est_ResetAxis(i, z); s_same[i] = EST_STILL; continue; }
+        } else {
+            s_same[i] = 0;
+        }
+        s_last_z[i] = z;
+
+        int32_t xp = s_m.pos[i] + (int32_t)(((int64_t)s_v_q8[i] * dt_q16) >> 24);
+        int32_t r  = z - xp;
+        if (iabs32(r) > (int32_t)XHC_EST_JUMP){ Est_ResetAxis(i, z); continue; }
+
+        s_m.pos[i] = xp + ((r * XHC_EST_ALPHA) >> 8);
+        int32_t dv = sat30(((int64_t)r * inv_dt * XHC_EST_BETA) >> 14);   /* Q8 */
+        s_v_q8[i] = sat30((int64_t)s_v_q8[i] + dv);
+
+        int32_t a = sat30(((int64_t)dv * inv_dt) >> 22);                  /* Einheiten/s² */
+        s_m.acc[i] += (int32_t)((((int64_t)a - s_m.acc[i]) * EST_ACC_K) >> 8);
+        s_m.vel[i] = s_v_q8[i] >> 8;
+        if (s_m.vel[i]) moving |= (uint8_t)(1u << i);
+    }
+    s_m.moving = moving;
+
+    /* Bahn über die Linearachsen; Rundachsen haben andere Einheiten */
+    uint64_t sq = 0;
+    for (uint8_t i = 0; i < 3u; ++i) sq += (uint64_t)((int64_t)s_m.vel[i] * s_m.vel[i]);
+    uint32_t speed = isqrt64(sq);
+    int32_t  a = sat30(((int64_t)speed - (int64_t)s_m.speed) * inv_dt >> 14);
+    s_m.path_acc += (int32_t)((((int64_t)a - s_m.path_acc) * EST_ACC_K) >> 8);
+    s_m.speed = speed;
+    if (!speed) s_m.path_acc = 0;
+}
+
+void XHC_Est_Tick(uint32_t cyc)
+{
+    /* keine Frames mehr: nichts bewegt sich, der nächste Frame startet neu */
+    if (!s_init || (cyc - s_cyc) / (SystemCoreClock / 1000u) <= XHC_EST_GAP_MS) return;
+    memset(s_m.vel, 0, sizeof(s_m.vel));
+    memset(s_m.acc, 0, sizeof(s_m.acc));
+    memset(s_v_q8, 0, sizeof(s_v_q8));
+    s_m.speed = 0; s_m.path_acc = 0; s_m.moving = 0;
+    s_init = 0;
+}
+
+int32_t XHC_Est_Extrapolate(uint8_t i, uint32_t cyc, uint16_t max_ms)
+{
+    int32_t v = s_m.vel[i];
+    /* letzter Frame wie der davor: Achse steht vermutlich schon */
+    if (!s_init || !v || s_same[i]) return 0;
+
+    uint32_t dt_us = (cyc - s_frame_cyc) / (SystemCoreClock / 1000000u);
+    if (dt_us > max_ms * 1000u) dt_us = max_ms * 1000u;
+    if (dt_us > XHC_EST_GAP_MS * 1000u) dt_us = XHC_EST_GAP_MS * 1000u;
+    int32_t dt_q16 = (int32_t)((dt_us * 4295u) >> 16);
+    int32_t a = s_m.acc[i];
+
+    /* bremst die Achse: höchstens bis zum Stillstand, nie zurück */
+    if (a && ((a < 0) != (v < 0)) &&
+        (((int64_t)iabs32(a) * dt_q16) >> 16) >= iabs32(v)){
+        return (int32_t)((int64_t)v * iabs32(v) / (2 * (int64_t)iabs32(a)));
+    }
+    /* v*dt + a*dt²/2, dt in Q16 */
+    return (int32_t)((((int64_t)v * dt_q16) >> 16) + (((int64_t)a * dt_q16 * dt_q16) >> 33));
+}
+
+const XHC_Motion *XHC_Est_Motion(void)
+{
+    return &s_m;
+}
+
+uint32_t XHC_Est_FeedPerMin(void)
+{
+    /* 1/10000 Einheit je s -> Einheit je min: *60/10000 */
+    return s_m.speed * 3u / 500u;   /* speed < 2^23, kein Überlauf */
+}
+
+uint32_t XHC_Est_DistToGo(void)
+{
+    /* s = v² / (2|a|), nur bei Verzögerung; nicht im Frame-Pfad */
+    if (s_m.path_acc > -EST_DTG_MIN_ACC || !s_m.speed) return 0;
+    uint64_t d = ((uint64_t)s_m.speed * s_m.speed) / (uint64_t)(2 * (int64_t)-s_m.path_acc);
+    return (d > 0xFFFFFFFFu) ? 0xFFFFFFFFu : (uint32_t)d;
+}
+
+#endif /* XHC_ESTIMATOR */
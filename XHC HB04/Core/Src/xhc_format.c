@@ -189,3 +189,21 @@ void xhc2string_align10(uint16_t iint, uint16_t ifrac, char *out10)
     for (int i=0;i<4;i++) *o++ = frac[i];
     *o = '\0';
 }
+
+void fixed4_align10(int32_t v, char *out10)
+{
+    uint32_t a = (v < 0) ? (uint32_t)0 - (uint32_t)v : (uint32_t)v;
+    uint32_t i = a / 10000u;
+    if (i > 0xFFFFu) i = 0xFFFFu;      /* ergibt "####" wie beim Frame */
+    uint16_t f = (uint16_t)(a % 10000u);
+    xhc2string_align10((uint16_t)i, (uint16_t)(f | ((v < 0) ? 0x8000u : 0u)), out10);
+}
+
+uint8_t uint2str(uint32_t value, uint8_t width, char pad, char *o)
+{
+    char *s = o; uint8_t c = 0;
+    do { *o++ = (char)('0' + value % 10u); value /= 10u; ++c; } while (value);
+    while (c < width){ *o++ = pad; ++c; }
+    *o = 0; strreverse(s, o - 1);
+    return c;
+}
@@ -0,0 +1,104 @@
+/*
+ * xhc_layout.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Layout-Engine für 3..6 Achsen (siehe xhc_layout.h)
+ */
+
+#include <string.h>
+#include "xhc_layout.h"
+
+#define LAY_CHAR_W    7u     /* Zeichenraster der Werte, wie CHAR_W im Renderer */
+#define LAY_VAL_CHARS 10u
+#define LAY_GRP_X     2u     /* "WC"/"MC" links */
+#define LAY_LBL_X     35u    /* "X:" */
+#define LAY_VAL_X     64u    /* 9*7+1: 10 Zeichen Font_13x13 enden bei 140 */
+
+static const char s_axis_chars[XHC_LAYOUT_MAX_AXES] = { 'X', 'Y', 'Z', 'A', 'B', 'C' };
+
+/* gestapelte Varianten: Zeilenabstand, erste Zeile, Luft über/unter dem Strich */
+typedef struct {
+    const FontDef *font;
+    uint8_t pitch, top, gap_above, gap_below;
+} stack_spec_t;
+
+static const stack_spec_t s_stack[] = {
+    { &Font_13x13, 12u, 2u, 4u, 7u },   /* 2/14/26, Strich 42, 50/62/74 wie bisher */
+    { &Font_7x10,  11u, 2u, 1u, 2u },
+};
+
+static uint8_t Try_Stack(XHC_Layout *l, const stack_spec_t *s, uint8_t n, uint16_t h)
+{
+    uint16_t div = (uint16_t)(s->top + n * s->pitch + s->gap_above);
+    uint16_t mc  = (uint16_t)(div + 1u + s->gap_below);
+    if (mc + (n - 1u) * s->pitch + s->font->height > h) return 0;
+
+    l->mode = XHC_LAY_STACK;
+    l->font = s->font;
+    for (uint8_t i = 0; i < n; ++i){
+        l->val_y[i]     = (uint8_t)(s->top + i * s->pitch);
+        l->val_y[n + i] = (uint8_t)(mc + i * s->pitch);
+    }
+    for (uint8_t f = 0; f < 2u * n; ++f){
+        l->val_x[f] = LAY_VAL_X;
+        l->lbl_x[f] = LAY_LBL_X;
+    }
+    l->grp_x[0] = l->grp_x[1] = LAY_GRP_X;
+    l->grp_y[0] = l->val_y[0];
+    l->grp_y[1] = l->val_y[n];
+    l->rule_y   = (uint8_t)div;
+    return 1;
+}
+
+/* zwei Spalten: Kopf, Strich, dann n Zeilen auf die Resthöhe verteilt.
+   Spalte = Buchstabe + 2 px + 10 Zeichen = 79 px, passt zweimal in 160 */
+static void Side(XHC_Layout *l, uint8_t n, uint16_t w, uint16_t h)
+{
+    const FontDef *f = &Font_7x10;
+    uint16_t colw  = (uint16_t)(w / 2u);
+    uint16_t head  = 1u;
+    uint16_t rule  = (uint16_t)(head + f->height + 1u);
+    uint16_t start = (uint16_t)(rule + 3u);
+    uint16_t pitch = (uint16_t)((h - start - f->height) / (n - 1u));
+    if (pitch > 16u) pitch = 16u;
+
+    l->mode = XHC_LAY_SIDE;
+    l->font = f;
+    for (uint8_t c = 0; c < 2u; ++c){
+        uint16_t cx = (uint16_t)(c * colw + 1u);
+        l->grp_x[c] = (uint8_t)cx;
+        l->grp_y[c] = (uint8_t)head;
+        for (uint8_t i = 0; i < n; ++i){
+            uint8_t fi = (uint8_t)(c * n + i);
+            l->lbl_x[fi] = (uint8_t)cx;
+            l->val_x[fi] = (uint8_t)(cx + LAY_CHAR_W + 2u);
+            l->val_y[fi] = (uint8_t)(start + i * pitch);
+        }
+    }
+    l->rule_y = (uint8_t)rule;
+}
+
+void XHC_Layout_Compute(XHC_Layout *l, uint8_t axes, uint16_t w, uint16_t h)
+{
+    if (axes < XHC_LAYOUT_MIN_AXES) axes = XHC_LAYOUT_MIN_AXES;
+    if (axes > XHC_LAYOUT_MAX_AXES) axes = XHC_LAYOUT_MAX_AXES;
+
+    memset(l, 0, sizeof(*l));
+    l->axes   = axes;
+    l->fields = (uint8_t)(2u * axes);
+
+    for (uint8_t k = 0; k < sizeof(s_stack) / sizeof(s_stack[0]); ++k){
+        if (Try_Stack(l, &s_stack[k], axes, h)) return;
+    }
+    Side(l, axes, w, h);
+}
+
+char XHC_Layout_AxisChar(const XHC_Layout *l, uint8_t field)
+{
+    return s_axis_chars[field % l->axes];
+}
+
+uint8_t XHC_Layout_IsMC(const XHC_Layout *l, uint8_t field)
+{
+    return field >= l->axes;
+}
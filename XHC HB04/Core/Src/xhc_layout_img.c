@@ -0,0 +1,62 @@
+/*
+ * xhc_layout_img.c
+ *
+ *  ERZEUGT von tools/gen_layout_image.py – nicht von Hand ändern.
+ *      Statisches Layout 160x128, 3 Farben, RLE 677 Byte (roh 40960 Byte RGB565)
+ */
+
+#include "xhc_layout_img.h"
+
+static const uint16_t s_palette[3] = {
+    0xFFFF, 0x0000, 0x001F
+};
+
+static const uint8_t s_rle[677] = {
+    0x0F,0xFF,0x0F,0xC4,0x11,0x02,0x11,0x01,0x11,0x04,0x12,0x0E,0x11,0x02,0x11,0x0F,
+    0x68,0x10,0x02,0x11,0x01,0x11,0x02,0x16,0x0C,0x11,0x01,0x11,0x0F,0x69,0x11,0x00,
+    0x12,0x01,0x11,0x02,0x11,0x02,0x11,0x0D,0x13,0x07,0x11,0x0F,0x60,0x11,0x00,0x10,
+    0x00,0x10,0x01,0x10,0x03,0x10,0x0F,0x04,0x13,0x07,0x11,0x0F,0x60,0x11,0x00,0x10,
+    0x00,0x10,0x00,0x11,0x03,0x10,0x0F,0x05,0x11,0x0F,0x6C,0x10,0x00,0x10,0x00,0x13,
+    0x03,0x10,0x0F,0x04,0x13,0x0F,0x6B,0x12,0x01,0x11,0x04,0x11,0x02,0x11,0x0D,0x13,
+    0x07,0x11,0x0F,0x61,0x12,0x01,0x11,0x04,0x11,0x02,0x11,0x0C,0x11,0x01,0x11,0x06,
+    0x11,0x0F,0x61,0x11,0x02,0x11,0x05,0x14,0x0D,0x11,0x01,0x12,0x0F,0xFF,0x0F,0xFF,
+    0x0F,0x4A,0x11,0x03,0x11,0x0F,0x89,0x11,0x01,0x11,0x0F,0x8B,0x10,0x01,0x11,0x06,
+    0x11,0x0F,0x82,0x13,0x07,0x11,0x0F,0x83,0x12,0x0F,0x8D,0x11,0x0F,0x8E,0x11,0x08,
+    0x11,0x0F,0x83,0x11,0x08,0x11,0x0F,0x83,0x11,0x0F,0xFF,0x0F,0xFF,0x0F,0x4D,0x16,
+    0x0F,0x89,0x16,0x0F,0x8D,0x11,0x07,0x11,0x0F,0x83,0x12,0x07,0x11,0x0F,0x83,0x11,
+    0x0F,0x8D,0x11,0x0F,0x8D,0x11,0x0A,0x11,0x0F,0x80,0x16,0x06,0x11,0x0F,0x80,0x16,
+    0x0F,0xFF,0x0F,0xFF,0x0F,0xFF,0x0F,0xF8,0x1F,0x90,0x0F,0xFF,0x0F,0xFF,0x0F,0xFF,
+    0x0F,0xFF,0x0F,0xB8,0x12,0x02,0x11,0x06,0x12,0x0E,0x11,0x02,0x11,0x0F,0x68,0x12,
+    0x01,0x12,0x04,0x16,0x0C,0x11,0x01,0x11,0x0F,0x69,0x12,0x01,0x10,0x00,0x10,0x04,
+    0x11,0x02,0x11,0x0D,0x13,0x07,0x11,0x0F,0x60,0x12,0x01,0x10,0x00,0x10,0x04,0x10,
+    0x0F,0x04,0x13,0x07,0x11,0x0F,0x60,0x12,0x01,0x10,0x00,0x10,0x04,0x10,0x0F,0x05,
+    0x11,0x0F,0x6B,0x15,0x00,0x10,0x04,0x10,0x0F,0x04,0x13,0x0F,0x6A,0x11,0x00,0x12,
+    0x00,0x10,0x04,0x11,0x02,0x11,0x0D,0x13,0x07,0x11,0x0F,0x60,0x11,0x00,0x11,0x01,
+    0x10,0x04,0x11,0x02,0x11,0x0C,0x11,0x01,0x11,0x06,0x11,0x0F,0x60,0x11,0x00,0x11,
+    0x01,0x10,0x05,0x14,0x0D,0x11,0x01,0x12,0x0F,0xFF,0x0F,0xFF,0x0F,0x4A,0x11,0x03,
+    0x11,0x0F,0x89,0x11,0x01,0x11,0x0F,0x8B,0x10,0x01,0x11,0x06,0x11,0x0F,0x82,0x13,
+    0x07,0x11,0x0F,0x83,0x12,0x0F,0x8D,0x11,0x0F,0x8E,0x11,0x08,0x11,0x0F,0x83,0x11,
+    0x08,0x11,0x0F,0x83,0x11,0x0F,0xFF,0x0F,0xFF,0x0F,0x4D,0x16,0x0F,0x89,0x16,0x0F,
+    0x8D,0x11,0x07,0x11,0x0F,0x83,0x12,0x07,0x11,0x0F,0x83,0x11,0x0F,0x8D,0x11,0x0F,
+    0x8D,0x11,0x0A,0x11,0x0F,0x80,0x16,0x06,0x11,0x0F,0x80,0x16,0x0F,0xFF,0x0F,0xFF,
+    0x0F,0xFF,0x0F,0xFF,0x0F,0xFF,0x0F,0xFF,0x0F,0xFF,0x0F,0x7C,0x2F,0xFF,0x2F,0xFF,
+    0x2F,0xFF,0x2F,0xFF,0x2F,0xFF,0x2F,0xFF,0x2F,0xFF,0x2F,0xFF,0x2F,0xFF,0x2F,0x6C,
+    0x04,0x23,0x0F,0x32,0x25,0x02,0x24,0x0F,0x32,0x24,0x00,0x27,0x00,0x2F,0x10,0x00,
+    0x2F,0x0F,0x00,0x24,0x00,0x22,0x00,0x23,0x00,0x2F,0x10,0x00,0x2F,0x0F,0x00,0x24,
+    0x00,0x27,0x00,0x2F,0x10,0x00,0x2F,0x0F,0x00,0x24,0x00,0x27,0x00,0x2F,0x10,0x00,
+    0x2F,0x0F,0x00,0x24,0x03,0x24,0x00,0x2F,0x10,0x00,0x2F,0x0F,0x00,0x25,0x01,0x25,
+    0x00,0x2F,0x10,0x00,0x2F,0x0F,0x00,0x24,0x00,0x27,0x00,0x2F,0x10,0x00,0x2F,0x0F,
+    0x00,0x27,0x00,0x24,0x00,0x2F,0x10,0x00,0x2F,0x0F,0x00,0x24,0x00,0x27,0x00,0x2F,
+    0x10,0x00,0x2F,0x0F,0x00,0x28,0x00,0x23,0x00,0x2F,0x10,0x00,0x2F,0x0F,0x00,0x24,
+    0x00,0x27,0x00,0x2F,0x10,0x00,0x2F,0x0F,0x00,0x24,0x00,0x22,0x00,0x23,0x00,0x2F,
+    0x10,0x00,0x2F,0x0F,0x00,0x24,0x00,0x27,0x00,0x2F,0x10,0x00,0x2F,0x0F,0x00,0x25,
+    0x02,0x24,0x00,0x2F,0x10,0x00,0x2F,0x0F,0x00,0x2D,0x00,0x2F,0x10,0x00,0x2F,0x0F,
+    0x00,0x2D,0x00,0x2F,0x10,0x00,0x2F,0x0F,0x00,0x2D,0x00,0x2F,0x10,0x00,0x2F,0x0F,
+    0x00,0x2D,0x00,0x2F,0x10,0x00,0x2F,0x0F,0x00,0x2D,0x00,0x2F,0x10,0x00,0x2F,0x0F,
+    0x00,0x2D,0x00,0x2F,0x10,0x00,0x2F,0x0F,0x00,0x2D,0x0F,0x32,0x2D,0x0F,0x32,0x2F,
+    0xFF,0x2F,0xFF,0x2F,0x54,
+};
+
+const XHC_RleImage XHC_Layout_Image = {
+    160, 128, 3, s_palette, s_rle, sizeof(s_rle)
+};
@@ -0,0 +1,156 @@
+/*
+ * xhc_proto.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Decoder der Pendant-Varianten -> XHC_MachineState (siehe xhc_proto.h).
+ *      Jeder Decoder baut aus dem alten Zustand den neuen, XHC_Ms_Commit
+ *      vergleicht beide feldweise und liefert die Änderungsmaske.
+ */
+
+#include <string.h>
+#include "xhc_proto.h"
+
+#define XHC_MAGIC0  0xFEu
+#define XHC_MAGIC1  0xFDu
+
+static uint8_t s_group = XHC_WHB04B_GROUP ? 1u : 0u;   /* WHB04B: 0 = X/Y/Z, 1 = A/B/C */
+
+static inline uint16_t rd16_le(const uint8_t *buf, uint8_t off) {
+    return (uint16_t)(buf[off] | ((uint16_t)buf[off+1] << 8));
+}
+
+/* {u16 int, u16 frac} mit Vorzeichen in frac bit15, 4 Nachkommastellen */
+static int32_t pos_frac4(const uint8_t *p)
+{
+    uint16_t fr = rd16_le(p, 2);
+    int32_t  v  = (int32_t)rd16_le(p, 0) * 10000 + (int32_t)(fr & 0x7FFFu);
+    return (fr & 0x8000u) ? -v : v;
+}
+
+/* neuen Zustand übernehmen, geänderte Felder melden */
+static uint16_t XHC_Ms_Commit(XHC_MachineState *ms, const XHC_MachineState *nw)
+{
+    uint16_t ch = 0;
+    for (uint8_t i = 0; i < XHC_AXES; ++i){
+        if (nw->wc[i] != ms->wc[i]) ch |= XHC_CH_WC(i);
+        if (nw->mc[i] != ms->mc[i]) ch |= XHC_CH_MC(i);
+    }
+    if (nw->feed_ovr != ms->feed_ovr || nw->feedrate != ms->feedrate)   ch |= XHC_CH_FEED;
+    if (nw->spindle_ovr != ms->spindle_ovr || nw->sspeed != ms->sspeed) ch |= XHC_CH_SPINDLE;
+    if (nw->step_mul != ms->step_mul || nw->state != ms->state || nw->day != ms->day) ch |= XHC_CH_MISC;
+    *ms = *nw;
+    return ch;
+}
+
+static inline uint8_t has_magic(const uint8_t *f)
+{
+    return f[0] == XHC_MAGIC0 && f[1] == XHC_MAGIC1;
+}
+
+void XHC_Proto_Reset(XHC_MachineState *ms)
+{
+    memset(ms, 0, sizeof(*ms));
+    ms->feed_ovr = 100u;
+    ms->spindle_ovr = 100u;
+}
+
+void XHC_Proto_SetAxisGroup(uint8_t abc)
+{
+    s_group = abc ? 1u : 0u;
+}
+
+uint8_t XHC_Proto_AxisGroup(void)
+{
+    return s_group;
+}
+
+/* ---- HB04: FE FD day, pos[6] je 4 B, feed_ovr (1/100 %), spindle_ovr (%),
+        feedrate, sspeed, step_mul, state = 37 Byte ---- */
+uint8_t XHC_Proto_DecodeHB04(const uint8_t *f, uint8_t len,
+                             XHC_MachineState *ms, uint16_t *changed)
+{
+    if (len < 37u || !has_magic(f)) return 0;
+    XHC_MachineState nw = *ms;
+    nw.day = f[2];
+    for (uint8_t i = 0; i < 3u; ++i){
+        nw.wc[i] = pos_frac4(&f[3u + 4u*i]);
+        nw.mc[i] = pos_frac4(&f[15u + 4u*i]);
+    }
+    nw.feed_ovr    = (uint16_t)((rd16_le(f, 27) + 50u) / 100u);
+    nw.spindle_ovr = rd16_le(f, 29);
+    nw.feedrate    = rd16_le(f, 31);
+    nw.sspeed      = rd16_le(f, 33);
+    nw.step_mul    = f[35];
+    nw.state       = f[36];
+    *changed = XHC_Ms_Commit(ms, &nw);
+    return 1;
+}
+
+#if XHC_PROTO == XHC_PROTO_HB03
+/* HB03: {u16 int, u8 frac} mit Vorzeichen in frac bit7, 2 Nachkommastellen */
+static int32_t pos_frac2(const uint8_t *p)
+{
+    uint8_t fr = p[2];
+    int32_t v  = (int32_t)rd16_le(p, 0) * 10000 + (int32_t)(fr & 0x7Fu) * 100;
+    return (fr & 0x80u) ? -v : v;
+}
+
+/* ---- HB03: wie HB04, Positionen aber nur 3 B = 31 Byte ---- */
+static uint8_t Decode_HB03(const uint8_t *f, uint8_t len,
+                           XHC_MachineState *ms, uint16_t *changed)
+{
+    if (len < 31u || !has_magic(f)) return 0;
+    XHC_MachineState nw = *ms;
+    nw.day = f[2];
+    for (uint8_t i = 0; i < 3u; ++i){
+        nw.wc[i] = pos_frac2(&f[3u + 3u*i]);
+        nw.mc[i] = pos_frac2(&f[12u + 3u*i]);
+    }
+    nw.feed_ovr    = (uint16_t)((rd16_le(f, 21) + 50u) / 100u);
+    nw.spindle_ovr = rd16_le(f, 23);
+    nw.feedrate    = rd16_le(f, 25);
+    nw.sspeed      = rd16_le(f, 27);
+    nw.step_mul    = f[29];
+    nw.state       = f[30];
+    *changed = XHC_Ms_Commit(ms, &nw);
+    return 1;
+}
+#endif
+
+#if XHC_PROTO == XHC_PROTO_WHB04B4 || XHC_PROTO == XHC_PROTO_WHB04B6
+/* ---- WHB04B: FE FD seed flags, row[3] je 4 B, feed, spindle (+ Füllbytes)
+        flags: bit0..1 Schrittmodus, bit6 Reset, bit7 relativ (= WC).
+        Die drei Zeilen gehören zur Gruppe am Achswahlschalter; Overrides
+        kennt das Protokoll nicht, die bleiben bei 100 %. ---- */
+static uint8_t Decode_WHB04B(const uint8_t *f, uint8_t len,
+                             XHC_MachineState *ms, uint16_t *changed)
+{
+    if (len < 20u || !has_magic(f)) return 0;
+    XHC_MachineState nw = *ms;
+    uint8_t flags = f[3];
+    int32_t *dst  = (flags & 0x80u) ? nw.wc : nw.mc;
+    uint8_t base  = s_group ? 3u : 0u;
+    for (uint8_t i = 0; i < 3u; ++i){
+        if (base + i < XHC_PROTO_AXES) dst[base + i] = pos_frac4(&f[4u + 4u*i]);
+    }
+    nw.feedrate = rd16_le(f, 16);
+    nw.sspeed   = rd16_le(f, 18);
+    nw.step_mul = (uint8_t)(flags & 0x03u);
+    nw.state    = flags;
+    nw.day      = f[2];
+    *changed = XHC_Ms_Commit(ms, &nw);
+    return 1;
+}
+#endif
+
+uint8_t XHC_Proto_Decode(const uint8_t *frame, uint8_t len,
+                         XHC_MachineState *ms, uint16_t *changed)
+{
+#if XHC_PROTO == XHC_PROTO_HB03
+    return Decode_HB03(frame, len, ms, changed);
+#elif XHC_PROTO == XHC_PROTO_HB04
+    return XHC_Proto_DecodeHB04(frame, len, ms, changed);
+#else
+    return Decode_WHB04B(frame, len, ms, changed);
+#endif
+}
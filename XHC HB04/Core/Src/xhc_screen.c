@@ -17,6 +17,19 @@
 #include "ST7735.h"
 #include "GFX_FUNCTIONS.h"
 #include "fonts.h"   /* für Font_7x10 und deine reesansbold9pt7b */
+#include "xhc_strip.h"
+#include "xhc_shadow.h"
+#include "xhc_digits.h"
+#include "xhc_seg.h"
+#include "xhc_config.h"
+#include "xhc_display.h"
+#include "xhc_boot.h"
+#include "xhc_telemetry.h"
+#include "xhc_layout_img.h"
+#include "xhc_proto.h"
+#include "xhc_layout.h"
+#include "xhc_estim.h"
+#include "xhc_bench.h"
 
 /* ==== Farb-/Display-Konstanten ==== */
 #ifndef WHITE
@@ -43,8 +56,7 @@
 /* ==== Protokoll-Konstanten ==== */
 #define XHC_FEAT_ID       0x06u
 #define XHC_CHUNK_SIZE    7u
-#define XHC_FRAME_SIZE    37u
-#define XHC_MAGIC_LE      0xFDFE
+#define XHC_FRAME_SIZE    37u    /* Schnellmodus 0x0D/0x0E: immer HB04-Layout */
 
 #define UI_MIN_PERIOD_MS  120u   /* sanftes Rate-Limit für Updates */
 #define FRAME_HOLD_MS     600u   /* nach vollständigem Frame: Quelle kurz halten */
@@ -55,11 +67,6 @@
 #define FOOT_X_L   2                 /* linker Block */
 #define FOOT_X_R   84                /* rechter Block (ca. Mitte + etwas Rand) */
 
-/* Offsets im 37B-Frame (Little Endian) */
-
-#define OFF_FEED_VAL   31  /* uint16_t, mm/min (typisch) */
-#define OFF_SPIND_VAL  33  /* uint16_t, RPM (typisch) */
-
 /* ---- zwei Spalten im Footer (nebeneinander) ---- */
 #define COL0_X0    2u
 #define COL0_X1   (LCD_W/2u - 2u)
@@ -93,14 +100,6 @@
 #define GREEN  0x07E0
 #endif
 
-/* Falls doppelt vorhanden: nur EIN Offsets-Block behalten! */
-#ifndef OFF_FEED_OVR
-#define OFF_FEED_OVR   27  /* uint16_t, Hundertstel-% */
-#endif
-#ifndef OFF_SPIND_OVR
-#define OFF_SPIND_OVR  29  /* uint16_t, % */
-#endif
-
 
 /* Farben (du hast BLUE/WHITE/BLACK schon) */
 #ifndef CYAN
@@ -110,34 +109,15 @@
 #define YELLOW 0xFFE0
 #endif
 
-/* Offsets im 37-Byte-Frame (LE) – nur für die Overrides */
-
-
-
 /* ---- forward declarations (needed before first use) ---- */
-static void DrawBarFrame(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+static void DrawBarFrame(int16_t x, int16_t y, int16_t w, int16_t h);
 static void DrawBarValue(uint8_t which,
                          uint16_t x, uint16_t y, uint16_t w, uint16_t h,
                          uint16_t pct, uint16_t minp, uint16_t maxp);
 
-static inline uint16_t rd16_le(const uint8_t *buf, uint8_t off) {
-    return (uint16_t)(buf[off] | ((uint16_t)buf[off+1] << 8));
-}
-
 
-/* ==== Frame-Struktur (gepackt) ==== */
-#pragma pack(push,1)
-typedef struct { uint16_t p_int; uint16_t p_frac; } xhc_pos_t;
-typedef struct {
-    uint16_t magic; uint8_t day;
-    xhc_pos_t pos[6];   /* [0..2]=Work X/Y/Z, [3..5]=Machine X/Y/Z */
-    uint16_t feedrate_ovr, sspeed_ovr, feedrate, sspeed;
-    uint8_t  step_mul, state;
-} whb04_out_data_t;
-#pragma pack(pop)
-
-/* ==== Assembler für 37B-Frame (Feature 0x06 in 7-Byte-Chunks) ==== */
-static uint8_t  asm_buf[XHC_FRAME_SIZE];
+/* ==== Assembler für den Frame der Variante (Feature 0x06 in 7-Byte-Chunks) ==== */
+static uint8_t  asm_buf[XHC_PROTO_FRAME_SIZE];
 static uint8_t  asm_len = 0;
 
 static inline void asm_reset(void){ asm_len = 0; }
@@ -152,7 +132,7 @@ static void asm_feed7(const uint8_t *p7)
         }
         return;
     }
-    uint8_t room = XHC_FRAME_SIZE - asm_len;
+    uint8_t room = XHC_PROTO_FRAME_SIZE - asm_len;
     uint8_t cp   = (room >= XHC_CHUNK_SIZE) ? XHC_CHUNK_SIZE : room;
     memcpy(&asm_buf[asm_len], p7, cp);
     asm_len += cp;
@@ -213,72 +193,113 @@ static void feat06_to_text_align10(const uint8_t *p7, char *out, uint16_t outsz)
 
 /* ==== UI-Layout (statisch) ==== */
 
-/* Y-Positionen der 6 Werte-Zeilen (in Pixel) */
-static const uint16_t s_val_y[6] = { 2, 14, 26, 50, 62, 74 };
-/* X-Start der Zahlen (möglichst bei vielfachem von 7, damit 10 Zeichen gut passen) */
-static const uint16_t s_val_x     = 64;  /* 9*7=63 → ~64 px ab linker Kante */
-
-/* Labels-Positionen */
-static const uint16_t s_wc_mc_x   = 2;
-static const uint16_t s_axis_x    = 35;  /* "X:" / "Y:" / "Z:" links von den Zahlen */
+/* Lage der Werte-Felder: aus der Achszahl berechnet (xhc_layout.c),
+   Felder 0..n-1 = WC, n..2n-1 = MC */
+static XHC_Layout s_lay;
 
-/* Divider & Blue-Bar */
-static const uint16_t s_div_y     = 42;  /* dünner Strich zwischen WC/MC */
-static const uint16_t s_blue_y    = 96;  /* Start der blauen Fußzeile */
+/* Blue-Bar */
+static const uint16_t s_blue_y    = 96;  /* Start der blauen Fußzeile = Höhe des Wertebereichs */
 
 /* Einmal-Flag für statischen Aufbau */
 static uint8_t s_static_drawn = 0;
 
-/* kleine Writer */
-static inline void PUT_STR(uint16_t x, uint16_t y, const char* s,
-                           const FontDef font, uint16_t fg, uint16_t bg)
+/* Zoom-DRO: ein Wert als 7-Segment-Anzeige über der blauen Leiste.
+   9 Zellen (Vorzeichen + 4 + 4 Stellen, Punkt hängt an der Zelle davor) */
+#define ZOOM_CELLS  9u
+#define ZOOM_DW     12u
+#define ZOOM_DH     40u
+#define ZOOM_Y      36u
+#define ZOOM_LBL_X  2
+#define ZOOM_LBL_Y  2
+#define ZOOM_RULE_Y 17             /* Strich unter dem Label */
+static int8_t       s_zoom = -1;
+static XHC_SegField s_zoom_field;
+
+/* statisches Layout (ein Band nach dem anderen, Hintergrund WHITE).
+   Das normale Layout steckt zusätzlich als RLE-Bild in xhc_layout_img.c
+   (tools/gen_layout_image.py) – Änderungen hier dort nachziehen. */
+static void Render_Static_Layout(void *ctx)
 {
-    ST7735_WriteString(x, y, s, font, fg, bg);
-}
+    (void)ctx;
+
+    /* blaue Leiste unten */
+    XHC_Strip_FillRect(0, s_blue_y, LCD_W, (int16_t)(LCD_H - s_blue_y), BLUE);
+
+    if (s_zoom >= 0){
+        /* Zoom: nur Label ("WC X"), die Ziffern zeichnet das Segmentfeld */
+        char lbl[5] = { 'W', 'C', ' ', XHC_Layout_AxisChar(&s_lay, (uint8_t)s_zoom), 0 };
+        if (XHC_Layout_IsMC(&s_lay, (uint8_t)s_zoom)) lbl[0] = 'M';
+        XHC_Strip_DrawString(ZOOM_LBL_X, ZOOM_LBL_Y, lbl, FONT_LABEL, BLACK, WHITE);
+        XHC_Strip_FillRect(0, ZOOM_RULE_Y, LCD_W, 1, BLACK);
+    } else {
+        /* WC/MC + Achsen-Labels ("X:" gestapelt, "X" in Spalten) */
+        FontDef font = *s_lay.font;
+        XHC_Strip_DrawString(s_lay.grp_x[0], s_lay.grp_y[0], "WC", font, BLACK, WHITE);
+        XHC_Strip_DrawString(s_lay.grp_x[1], s_lay.grp_y[1], "MC", font, BLACK, WHITE);
+        for (uint8_t f = 0; f < s_lay.fields; ++f){
+            char lbl[3] = { XHC_Layout_AxisChar(&s_lay, f), ':', 0 };
+            if (s_lay.mode == XHC_LAY_SIDE) lbl[1] = 0;
+            XHC_Strip_DrawString(s_lay.lbl_x[f], s_lay.val_y[f], lbl, font, BLACK, WHITE);
+        }
+
+        /* Divider */
+        XHC_Strip_FillRect(0, s_lay.rule_y, LCD_W, 1, BLACK);
+    }
 
+    /* Progressbar-Labels + Rahmen */
+    XHC_Strip_DrawString(F_LABEL_X, BARS_Y, "F", Font_7x10, WHITE, BLUE);
+    XHC_Strip_DrawString(S_LABEL_X, BARS_Y, "S", Font_7x10, WHITE, BLUE);
 
+    DrawBarFrame(F_BAR_X, BARS_Y, F_BAR_W, BAR_H);
+    DrawBarFrame(S_BAR_X, BARS_Y, S_BAR_W, BAR_H);
+}
 
 /* statisches Layout genau einmal zeichnen */
 static void Draw_Static_Layout_Once(void)
 {
     if (s_static_drawn) return;
+    if (XHC_Display_LogActive()) return;   /* Panel steht hochkant, nach dem Log */
     s_static_drawn = 1;
 
-    /* Hintergrund + blaue Leiste unten */
-    fillScreen(WHITE);  // ggf. schon in main gemacht; auskommentiert, wenn unerwünscht
-    fillRect(0, s_blue_y, LCD_W, (uint16_t)(LCD_H - s_blue_y), BLUE);
-
-    /* WC/MC + Achsen-Labels */
-    PUT_STR(s_wc_mc_x, s_val_y[0], "WC", FONT_LABEL, BLACK, WHITE);
-    PUT_STR(s_axis_x,  s_val_y[0], "X:", FONT_LABEL, BLACK, WHITE);
-    PUT_STR(s_axis_x,  s_val_y[1], "Y:", FONT_LABEL, BLACK, WHITE);
-    PUT_STR(s_axis_x,  s_val_y[2], "Z:", FONT_LABEL, BLACK, WHITE);
-
-    /* Divider */
-    fillRect(0, s_div_y, LCD_W, 1, BLACK);
-
-    PUT_STR(s_wc_mc_x, s_val_y[3], "MC", FONT_LABEL, BLACK, WHITE);
-    PUT_STR(s_axis_x,  s_val_y[3], "X:", FONT_LABEL, BLACK, WHITE);
-    PUT_STR(s_axis_x,  s_val_y[4], "Y:", FONT_LABEL, BLACK, WHITE);
-    PUT_STR(s_axis_x,  s_val_y[5], "Z:", FONT_LABEL, BLACK, WHITE);
-
-    /* Progressbar-Labels + Rahmen (einmalig) */
-    ST7735_WriteString(F_LABEL_X, BARS_Y, "F", Font_7x10, WHITE, BLUE);
-    ST7735_WriteString(S_LABEL_X, BARS_Y, "S", Font_7x10, WHITE, BLUE);
-
-    DrawBarFrame(F_BAR_X, BARS_Y, F_BAR_W, BAR_H);
-    DrawBarFrame(S_BAR_X, BARS_Y, S_BAR_W, BAR_H);
+#if XHC_LAYOUT_IMAGE
+    /* das Bild gibt es nur für das klassische 3-Achsen-Layout */
+    if (s_zoom < 0 && s_lay.axes == 3u){
+        /* fertiges Bild aus dem Flash: nur Entpacken + DMA je Band */
+        XHC_Strip_Image(0, 0, &XHC_Layout_Image);
+        return;
+    }
+#endif
+    /* ganzer Bildschirm in 16-Zeilen-Bändern statt fillScreen + Einzelteile */
+    XHC_Strip_Render(0, 0, LCD_W, LCD_H, WHITE, Render_Static_Layout, NULL);
 }
 
 /* ==== Werte-Zeichnen mit minimalem Redraw (nur Änderungen) ==== */
-static char s_last_val[6][12];  /* 10 Zeichen + 0, etwas Reserve */
-static uint8_t s_last_len[6];   /* jeweils 10 */
+static char s_last_val[XHC_LAYOUT_MAX_FIELDS][12];  /* 10 Zeichen + 0, etwas Reserve */
+static uint8_t s_last_len[XHC_LAYOUT_MAX_FIELDS];   /* jeweils 10 */
 
 /* ==== Footer (blauer Streifen) – 4 Text-Slots: 0=F% 1=S% 2=F 3=S ==== */
 static char s_last_bot[4][16];     /* jeder Slot bis ~15 Zeichen */
 static uint8_t s_last_bot_len[4];
 
 
+/* Footer-Text als eine Region neu aufbauen: Zellen first..end-1 */
+typedef struct {
+    uint16_t x, y;
+    uint8_t  first, end;
+    const char *txt;
+    uint8_t  len;
+} footer_job_t;
+
+static void Render_Footer_Span(void *ctx)
+{
+    const footer_job_t *j = (const footer_job_t*)ctx;
+    for (uint8_t i = j->first; i < j->end && i < j->len; ++i){
+        XHC_Strip_DrawChar((int16_t)(j->x + i*CHAR_W), (int16_t)j->y, j->txt[i],
+                           Font_7x10, WHITE, BLUE);
+    }
+    /* Zellen hinter len bleiben blau (= überhängende alte Zeichen gelöscht) */
+}
+
 static inline void DrawFooterText(uint8_t slot, uint16_t x, uint16_t y, const char* txt)
 {
     if (slot > 3) return;
@@ -286,27 +307,31 @@ static inline void DrawFooterText(uint8_t slot, uint16_t x, uint16_t y, const ch
     uint8_t oldlen = s_last_bot_len[slot];
     uint8_t len    = (uint8_t)strlen(txt);
     if (len > 15) len = 15;
+    /* nicht über den rechten Displayrand hinaus zeichnen */
+    if (x + len*CHAR_W > LCD_W) len = (uint8_t)((LCD_W - x) / CHAR_W);
 
-    /* 1) Gemeinsame Präfix-Länge diffbasiert (kein Clear nötig) */
-    uint8_t common = (oldlen < len) ? oldlen : len;
-    for (uint8_t i = 0; i < common; ++i){
-        char nc = txt[i], oc = s_last_bot[slot][i];
+    /* erste/letzte geänderte Zelle suchen (kürzer geworden = Zellen löschen) */
+    uint8_t maxlen = (oldlen > len) ? oldlen : len;
+    uint8_t first = maxlen, end = 0;
+#if XHC_SHADOW_FB
+    first = 0; end = maxlen;   /* Diff macht der Schattenpuffer */
+#else
+    for (uint8_t i = 0; i < maxlen; ++i){
+        char nc = (i < len)    ? txt[i]              : 0;
+        char oc = (i < oldlen) ? s_last_bot[slot][i] : 0;
         if (nc != oc){
-            char s[2] = { nc, 0 };
-            ST7735_WriteString((uint16_t)(x + i*CHAR_W), y, s, Font_7x10, WHITE, BLUE);
+            if (first == maxlen) first = i;
+            end = (uint8_t)(i + 1u);
         }
     }
+#endif
 
-    /* 2) Neue zusätzliche Zeichen schreiben (falls länger geworden) */
-    for (uint8_t i = common; i < len; ++i){
-        char s[2] = { txt[i], 0 };
-        ST7735_WriteString((uint16_t)(x + i*CHAR_W), y, s, Font_7x10, WHITE, BLUE);
-    }
-
-    /* 3) Überhängende alte Zeichen entfernen (falls kürzer geworden) */
-    for (uint8_t i = len; i < oldlen; ++i){
-        /* Zelle gezielt löschen */
-        fillRect((uint16_t)(x + i*CHAR_W), y, CHAR_W, LINE_H, BLUE);
+    /* alle geänderten Zellen in einem Rutsch (ein DMA-Transfer) */
+    if (first < end){
+        footer_job_t j = { x, y, first, end, txt, len };
+        XHC_Strip_Render((uint16_t)(x + first*CHAR_W), y,
+                         (uint16_t)((end - first)*CHAR_W), LINE_H,
+                         BLUE, Render_Footer_Span, &j);
     }
 
     /* Cache aktualisieren */
@@ -315,70 +340,81 @@ static inline void DrawFooterText(uint8_t slot, uint16_t x, uint16_t y, const ch
     s_last_bot_len[slot]  = len;
 }
 
+#if XHC_ESTIMATOR
+/* obere Footer-Zeile: Ist-Vorschub (Einheiten/min) links,
+   Bahnbeschleunigung (Einheiten/s²) rechts – DrawFooterText diffed */
+static void Draw_Motion(void)
+{
+    const XHC_Motion *m = XHC_Est_Motion();
+    char txt[16];
+    /* auf 5 Stellen begrenzen: "a+99999/s2" endet ab FOOT_X_R bei x=154 */
+    uint32_t v = XHC_Est_FeedPerMin();
+    int32_t  a = m->path_acc / 10000;
+    if (v > 99999u) v = 99999u;
+    if (a >  99999) a =  99999;
+    if (a < -99999) a = -99999;
+    snprintf(txt, sizeof(txt), "v%5lu/min", (unsigned long)v);
+    DrawFooterText(2, FOOT_X_L, FOOT_Y_A, txt);
+    snprintf(txt, sizeof(txt), "a%+6ld/s2", (long)a);
+    DrawFooterText(3, FOOT_X_R, FOOT_Y_A, txt);
+}
+#endif
+
 /* letzter angezeigter Prozentwert je Bar (zum Skippen unveränderter Frames) */
 static uint16_t s_last_bar_val[2] = { 0xFFFF, 0xFFFF };
 static uint32_t s_last_bar_t[2] = {0, 0};
 
-/* Rahmen einer Bar einmalig zeichnen (blauer Hintergrund ist schon da) */
-static void DrawBarFrame(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+/* Rahmen einer Bar (blauer Hintergrund ist schon da) */
+static void DrawBarFrame(int16_t x, int16_t y, int16_t w, int16_t h)
 {
     /* Bar-Outline */
-    drawRect(x, y, w, h, WHITE);
+    XHC_Strip_DrawRect(x, y, w, h, WHITE);
     /* Center-Marker (100%) */
-    uint16_t cx = (uint16_t)(x + w/2u);
-    drawFastVLine(cx, (int16_t)(y+1), (int16_t)(h-2), WHITE);
+    int16_t cx = (int16_t)(x + w/2);
+    XHC_Strip_FillRect(cx, (int16_t)(y+1), 1, (int16_t)(h-2), WHITE);
 }
 
-/* Bar-Inhalt neu zeichnen (nur bei Wertänderung).
-   min/max: Prozentbereiche (z.B. F:0..250, S:50..150) */
-static void DrawBarValue(uint8_t which /*0=F,1=S*/,
-                         uint16_t x, uint16_t y, uint16_t w, uint16_t h,
-                         uint16_t pct, uint16_t minp, uint16_t maxp)
-{
-
-	uint32_t now = HAL_GetTick();
-	if ((now - s_last_bar_t[which]) < BAR_MIN_PERIOD_MS && pct != 100u) {
-	    return;   // zu früh, diesen Zwischenschritt überspringen
-	}
-
-
-    if (pct == s_last_bar_val[which]) return;  /* nix zu tun */
-
-    if (pct < minp) pct = minp;
-    if (pct > maxp) pct = maxp;
+typedef struct {
+    int16_t  x, y, w, h;
+    uint16_t pct, minp, maxp;
+} bar_job_t;
 
-    /* Innenraum wischen (Outline + Center stehen lassen) */
-    fillRect((int16_t)(x+1), (int16_t)(y+1), (int16_t)(w-2), (int16_t)(h-2), BLUE);
+/* komplette Bar (Rahmen, Füllung, Text) in ein Band komponieren */
+static void Render_Bar(void *ctx)
+{
+    const bar_job_t *b = (const bar_job_t*)ctx;
+    int16_t x = b->x, y = b->y, w = b->w, h = b->h;
+    uint16_t pct = b->pct, minp = b->minp, maxp = b->maxp;
 
-    /* Center-Linie (100%) */
-    uint16_t cx = (uint16_t)(x + w/2u);
-    drawFastVLine((int16_t)cx, (int16_t)(y+1), (int16_t)(h-2), WHITE);
+    /* Rahmen + Center-Linie (100%) */
+    DrawBarFrame(x, y, w, h);
+    int16_t cx = (int16_t)(x + w/2);
 
     /* Füllung einfärben: links <100% = ROT, rechts >100% = GRÜN */
     if (pct > 100u) {
         /* rechts: von cx nach rechts */
     	uint32_t span   = (uint32_t)(maxp - 100u);
     	uint32_t rel    = (uint32_t)(pct  - 100u);
-    	uint16_t len_px = (span ? (uint16_t)((rel * (w/2u) + span/2u)/span) : 0u);
+    	uint16_t len_px = (span ? (uint16_t)((rel * (uint32_t)(w/2) + span/2u)/span) : 0u);
     	/* >>> Clamp, damit nie bis in den Rahmen gemalt wird */
-    	uint16_t max_len = (uint16_t)(w/2u - 1u);
+    	uint16_t max_len = (uint16_t)(w/2 - 1);
     	if (len_px > max_len) len_px = max_len;
 
     	if (len_px) {
-    	    fillRect((int16_t)cx, (int16_t)(y+1), (int16_t)len_px, (int16_t)(h-2), GREEN);
+    	    XHC_Strip_FillRect(cx, (int16_t)(y+1), (int16_t)len_px, (int16_t)(h-2), GREEN);
     	}
     } else if (pct < 100u) {
         /* links: von cx-len nach links */
     	uint32_t span   = (uint32_t)(100u - minp);
     	uint32_t rel    = (uint32_t)(100u - pct);
-    	uint16_t len_px = (span ? (uint16_t)((rel * (w/2u) + span/2u)/span) : 0u);
+    	uint16_t len_px = (span ? (uint16_t)((rel * (uint32_t)(w/2) + span/2u)/span) : 0u);
     	/* >>> Clamp wie oben */
-    	uint16_t max_len = (uint16_t)(w/2u - 1u);
+    	uint16_t max_len = (uint16_t)(w/2 - 1);
     	if (len_px > max_len) len_px = max_len;
 
     	if (len_px) {
-    	    fillRect((int16_t)(cx - len_px), (int16_t)(y+1),
-    	             (int16_t)len_px, (int16_t)(h-2), RED);
+    	    XHC_Strip_FillRect((int16_t)(cx - len_px), (int16_t)(y+1),
+    	                       (int16_t)len_px, (int16_t)(h-2), RED);
     	}
     }
 
@@ -387,27 +423,100 @@ static void DrawBarValue(uint8_t which /*0=F,1=S*/,
     int n = snprintf(txt, sizeof(txt), "%u%%", (unsigned)pct);
     if (n < 0) txt[0] = 0;
 
-    uint16_t tw = (uint16_t)(strlen(txt) * CHAR_W);
-    uint16_t tx = (uint16_t)(x + (w - tw)/2u);
-    uint16_t ty = (h > LINE_H) ? (uint16_t)(y + (h - LINE_H)/2u) : y;
+    int16_t tw = (int16_t)(strlen(txt) * CHAR_W);
+    int16_t tx = (int16_t)(x + (w - tw)/2);
+    int16_t ty = (h > (int16_t)LINE_H) ? (int16_t)(y + (h - (int16_t)LINE_H)/2) : y;
 
-    /* Text-Hintergrund leicht „säubern“, dann Text zeichnen */
-    fillRect((int16_t)tx, (int16_t)ty, (int16_t)tw, (int16_t)LINE_H, BLUE);
-    ST7735_WriteString(tx, ty, txt, Font_7x10, WHITE, BLUE);
+    /* Text-Hintergrund „säubern“, dann Text zeichnen */
+    XHC_Strip_FillRect(tx, ty, tw, (int16_t)LINE_H, BLUE);
+    XHC_Strip_DrawString(tx, ty, txt, Font_7x10, WHITE, BLUE);
+}
+
+/* Bar-Inhalt neu zeichnen (nur bei Wertänderung).
+   min/max: Prozentbereiche (z.B. F:0..250, S:50..150) */
+static void DrawBarValue(uint8_t which /*0=F,1=S*/,
+                         uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                         uint16_t pct, uint16_t minp, uint16_t maxp)
+{
+
+	uint32_t now = HAL_GetTick();
+	if ((now - s_last_bar_t[which]) < BAR_MIN_PERIOD_MS && pct != 100u) {
+	    return;   // zu früh, diesen Zwischenschritt überspringen
+	}
+
+
+    if (pct == s_last_bar_val[which]) return;  /* nix zu tun */
+
+    if (pct < minp) pct = minp;
+    if (pct > maxp) pct = maxp;
+
+    /* Bar im RAM komponieren und in einem Transfer ausgeben –
+       kein sichtbares Wischen-dann-Füllen mehr */
+    bar_job_t b = { (int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h, pct, minp, maxp };
+    XHC_Strip_Render(x, y, w, h, BLUE, Render_Bar, &b);
 
     s_last_bar_val[which] = pct;
     s_last_bar_t[which]   = now;
 }
 
 
-static void Draw_Value_Aligned(uint8_t idx /*0..5*/, const char* val10)
+/* Werte-Zeile: Zeichen first..end-1 (Raster CHAR_W, Glyphen überlappen) */
+typedef struct {
+    uint16_t x0, y;
+    uint8_t  first, end;
+    const char *txt;
+    uint8_t  len;
+} value_job_t;
+
+static void Render_Value_Span(void *ctx)
+{
+    const value_job_t *j = (const value_job_t*)ctx;
+    /* Nachbarn mitzeichnen, deren Glyphe in die Region ragt; aufsteigend,
+       damit wie bisher das rechte Zeichen das linke überdeckt */
+    uint8_t k0 = j->first ? (uint8_t)(j->first - 1u) : 0u;
+    uint8_t k1 = (uint8_t)(j->end + 1u);
+    if (k1 > 10u) k1 = 10u;
+    for (uint8_t k = k0; k < k1; ++k){
+        char c = (k < j->len) ? j->txt[k] : ' ';
+        XHC_Strip_DrawChar((int16_t)(j->x0 + k*CHAR_W), (int16_t)j->y, c,
+                           *s_lay.font, BLACK, WHITE);
+    }
+}
+
+#if XHC_DIGIT_SPRITES && !XHC_SHADOW_FB
+/* Jedes geänderte Zeichen als fertige Zelle aus dem Flash blitten.
+   Die Tinte aller Sprite-Zeichen liegt innerhalb der CHAR_W-Zelle, der
+   Nachbar bleibt also unberührt. Ausnahme '#' ganz rechts (ragt in Spalte 7):
+   dann, wie bei fremden Zeichen, 0 zurück und der Strip-Pfad übernimmt. */
+static uint8_t Blit_Value_Sprites(uint16_t x0, uint16_t y, uint8_t first, uint8_t end,
+                                  const char* txt, uint8_t len,
+                                  const char* old, uint8_t oldlen)
+{
+    for (uint8_t i = first; i < end; ++i){
+        char nc = (i < len) ? txt[i] : ' ';
+        char oc = (i < oldlen) ? old[i] : ' ';
+        if (!XHC_Digit_Sprite(nc)) return 0;
+        if (i == 9u && (nc == '#' || oc == '#')) return 0;
+    }
+    for (uint8_t i = first; i < end; ++i){
+        char nc = (i < len) ? txt[i] : ' ';
+        char oc = (i < oldlen) ? old[i] : ' ';
+        if (nc == oc) continue;
+        ST7735_DrawImageDMA((uint16_t)(x0 + i*CHAR_W), y, XHC_DIGIT_W, XHC_DIGIT_H,
+                            (const uint8_t*)XHC_Digit_Sprite(nc));
+    }
+    return 1;
+}
+#endif
+
+static void Draw_Value_Aligned(uint8_t idx /*Feld*/, const char* val10)
 {
-    if (idx > 5) return;
+    if (idx >= s_lay.fields) return;
 
-    uint16_t x0 = s_val_x;
-    uint16_t y  = s_val_y[idx];
+    uint16_t x0 = s_lay.val_x[idx];
+    uint16_t y  = s_lay.val_y[idx];
 
-    /* Vergleichen & nur differente Zeichen neu zeichnen */
+    /* Vergleichen & nur den Bereich differenter Zeichen neu zeichnen */
     const char* old = s_last_val[idx];
     uint8_t oldlen  = s_last_len[idx];
 
@@ -415,14 +524,36 @@ static void Draw_Value_Aligned(uint8_t idx /*0..5*/, const char* val10)
     if (len > 10) len = 10;
 
     uint8_t maxlen = (oldlen > len) ? oldlen : len;
+    uint8_t first = maxlen, end = 0;
+#if XHC_SHADOW_FB
+    /* Schattenpuffer diffed pixelgenau – ganze Zeile komponieren */
+    (void)old;
+    first = 0; end = maxlen;
+#else
     for (uint8_t i = 0; i < maxlen; ++i){
         char nc = (i < len)    ? val10[i]    : ' ';
         char oc = (i < oldlen) ? old[i]      : ' ';
         if (nc != oc){
-            char s[2] = { nc, 0 };
-            ST7735_WriteString((uint16_t)(x0 + i*CHAR_W), y, s, Font_13x13, BLACK, WHITE);
+            if (first == maxlen) first = i;
+            end = (uint8_t)(i + 1u);
         }
     }
+#endif
+
+#if XHC_DIGIT_SPRITES && !XHC_SHADOW_FB
+    /* Sprites gibt es nur für Font_13x13 */
+    if (first < end && s_lay.font == &Font_13x13 &&
+        Blit_Value_Sprites(x0, y, first, end, val10, len, old, oldlen)) first = end;
+#endif
+
+    if (first < end){
+        /* eine Region von der ersten bis zur letzten Änderung, ein DMA-Transfer */
+        value_job_t j = { x0, y, first, end, val10, len };
+        uint16_t rx = (uint16_t)(x0 + first*CHAR_W);
+        uint16_t rw = (uint16_t)((end - 1u - first)*CHAR_W + s_lay.font->width);
+        XHC_Strip_Render(rx, y, rw, s_lay.font->height, WHITE, Render_Value_Span, &j);
+    }
+
     /* Cache aktualisieren */
     memcpy(s_last_val[idx], val10, len);
     s_last_val[idx][len] = 0;
@@ -433,12 +564,173 @@ static void Draw_Value_Aligned(uint8_t idx /*0..5*/, const char* val10)
 static uint8_t  live_payload[7];
 static uint8_t  have_live = 0;
 
-static uint8_t  frame_cache[XHC_FRAME_SIZE];
+static uint8_t  frame_cache[XHC_FRAME_SIZE];   /* HB04-Basis für Deltas */
+static uint8_t  have_base  = 0;                /* frame_cache gültig */
+static XHC_MachineState s_ms;                  /* dekodierter Stand, das zeigt der Renderer */
 static uint8_t  have_frame = 0;
 static uint32_t frame_t    = 0;
 
 static uint8_t  shown_source = 0; /* 0=nix, 1=LIVE, 2=FRAME */
 static uint32_t t_last_draw  = 0;
+static uint8_t  s_dro_marked = 0; /* Boot-Marke "dro" gesetzt */
+static uint16_t s_min_period = UI_MIN_PERIOD_MS;   /* zur Laufzeit über die Konsole */
+
+/* ==== Delta-Reports (0x0E): nur geänderte Felder auf frame_cache ==== */
+/* Offset/Länge je Maskenbit im 37B-Frame, Reihenfolge = Bit-Reihenfolge */
+static const uint8_t s_delta_off[XHC_DELTA_FIELDS] = { 3, 7, 11, 15, 19, 23, 27, 29, 31, 33, 35, 36, 2 };
+static const uint8_t s_delta_len[XHC_DELTA_FIELDS] = { 4, 4,  4,  4,  4,  4,  2,  2,  2,  2,  1,  1, 1 };
+
+#define DIRTY_ALL  XHC_CH_ALL
+static uint16_t s_frame_dirty = DIRTY_ALL;   /* seit dem letzten Zeichnen geänderte Felder (XHC_CH_*) */
+
+/* Feld (0..n-1 WC, n..2n-1 MC) -> Bit der Änderungsmaske bzw. Wert */
+static inline uint16_t Field_Bit(uint8_t f)
+{
+    return (f < s_lay.axes) ? XHC_CH_WC(f) : XHC_CH_MC(f - s_lay.axes);
+}
+
+#if XHC_INTERP
+static int32_t s_interp_d[XHC_AXES];   /* Zuschlag je Achse in dieser Runde */
+static uint8_t s_interp_axes;          /* Achsen, deren Anzeige gerade extrapoliert ist */
+
+/* Zuschläge für jetzt berechnen; dirty = Felder bewegter Achsen und
+   solcher, die zuletzt extrapoliert waren (-> zurück auf den echten Wert) */
+static uint16_t Interp_Prepare(void)
+{
+    uint32_t cyc = XHC_Bench_Cycles();
+    uint16_t dirty = 0;
+    uint8_t  axes = 0;
+    for (uint8_t i = 0; i < s_lay.axes; ++i){
+        int32_t d = XHC_Est_Extrapolate(i, cyc, XHC_INTERP_MAX_MS);
+        if (d || (s_interp_axes & (1u << i))) dirty |= (uint16_t)(XHC_CH_WC(i) | XHC_CH_MC(i));
+        if (d) axes |= (uint8_t)(1u << i);
+        s_interp_d[i] = d;
+    }
+    s_interp_axes = axes;
+    return dirty;
+}
+#endif
+
+static inline int32_t Field_Value(uint8_t f)
+{
+    uint8_t a = (f < s_lay.axes) ? f : (uint8_t)(f - s_lay.axes);
+    int32_t v = (f < s_lay.axes) ? s_ms.wc[a] : s_ms.mc[a];
+#if XHC_INTERP
+    v += s_interp_d[a];
+#endif
+    return v;
+}
+
+#if XHC_ESTIMATOR
+static uint8_t s_est_wc = 0;   /* Schätzer läuft auf WC statt MC (WHB04B relativ) */
+#endif
+
+/* Frame-Stand übernehmen: Decode liefert, was sich wirklich geändert hat */
+static void Frame_Commit(uint8_t kind, uint16_t changed)
+{
+    have_frame = 1;
+    s_frame_dirty |= changed;
+    XHC_Tel_Log(TEL_FRAME, kind, changed);
+
+#if XHC_ESTIMATOR
+    /* MC bevorzugt (Nullpunktwechsel springen nicht); liefert die Variante
+       nur WC, bleibt der Schätzer dort, bis wieder MC kommt */
+    if (changed & XHC_CH_MC_ALL)      s_est_wc = 0;
+    else if (changed & XHC_CH_WC_ALL) s_est_wc = 1;
+    XHC_Est_Update(s_est_wc ? s_ms.wc : s_ms.mc, XHC_Bench_Cycles());
+#endif
+}
+
+/* Delta auf den gecachten Frame anwenden; 0 = verworfen (kein Basis-Frame,
+   zu kurz, unbekannte Bits) – dann bleibt der Cache unverändert */
+static uint8_t Apply_Delta(const uint8_t *p, uint16_t n)
+{
+    if (!have_base || n < 2u) return 0;
+    uint16_t mask = (uint16_t)(p[0] | (p[1] << 8));
+    if (mask >> XHC_DELTA_FIELDS) return 0;
+
+    /* erst Länge prüfen, damit kein halbes Delta im Cache landet */
+    uint16_t need = 2;
+    for (uint8_t b = 0; b < XHC_DELTA_FIELDS; ++b)
+        if (mask & (1u << b)) need = (uint16_t)(need + s_delta_len[b]);
+    if (n < need) return 0;
+
+    p += 2;
+    for (uint8_t b = 0; b < XHC_DELTA_FIELDS; ++b){
+        if (!(mask & (1u << b))) continue;
+        memcpy(&frame_cache[s_delta_off[b]], p, s_delta_len[b]);
+        p += s_delta_len[b];
+    }
+    uint16_t changed;
+    XHC_Proto_DecodeHB04(frame_cache, XHC_FRAME_SIZE, &s_ms, &changed);
+    Frame_Commit(2u, changed);
+    return 1;
+}
+
+/* ==== Selbstheilung: ein Streifen je Leerlauf-Frame ==== */
+#if XHC_HEAL
+static uint16_t s_heal_y = 0;
+static uint32_t s_heal_t = 0;
+
+#if !XHC_SHADOW_FB
+/* Streifen komplett aus Layout + Caches komponieren (Strip clippt) */
+static void Render_Heal(void *ctx)
+{
+    (void)ctx;
+    Render_Static_Layout(NULL);
+
+    if (s_zoom >= 0){
+        XHC_Seg_Strip(&s_zoom_field);
+    } else {
+        for (uint8_t i = 0; i < s_lay.fields; ++i){
+            /* aufsteigend wie Render_Value_Span: rechts überdeckt links */
+            for (uint8_t k = 0; k < s_last_len[i]; ++k){
+                XHC_Strip_DrawChar((int16_t)(s_lay.val_x[i] + k*CHAR_W), (int16_t)s_lay.val_y[i],
+                                   s_last_val[i][k], *s_lay.font, BLACK, WHITE);
+            }
+        }
+    }
+
+    /* Footer-Texte (Slots 2/3 = obere Zeile) */
+    footer_job_t fl = { FOOT_X_L, FOOT_Y_A, 0, 15, s_last_bot[2], s_last_bot_len[2] };
+    footer_job_t fr = { FOOT_X_R, FOOT_Y_A, 0, 15, s_last_bot[3], s_last_bot_len[3] };
+    Render_Footer_Span(&fl);
+    Render_Footer_Span(&fr);
+
+    /* Bereiche wie in RenderScreen: F 0..250 %, S 50..150 % */
+    if (s_last_bar_val[0] != 0xFFFFu){
+        bar_job_t b = { F_BAR_X, BARS_Y, F_BAR_W, BAR_H, s_last_bar_val[0], 0u, 250u };
+        Render_Bar(&b);
+    }
+    if (s_last_bar_val[1] != 0xFFFFu){
+        bar_job_t b = { S_BAR_X, BARS_Y, S_BAR_W, BAR_H, s_last_bar_val[1], 50u, 150u };
+        Render_Bar(&b);
+    }
+}
+#endif
+
+static void Heal_Tick(uint32_t now)
+{
+    if (!s_static_drawn || (now - s_heal_t) < XHC_HEAL_PERIOD_MS) return;
+    if (XHC_Display_LogActive()) return; /* Panel steht hochkant, Strips passen nicht */
+    if (ST7735_DMABusy()) return;        /* nur in echtem Leerlauf */
+    s_heal_t = now;
+
+#if XHC_HEAL_REGS
+    if (s_heal_y == 0u) ST7735_RefreshConfig();
+#endif
+#if XHC_SHADOW_FB
+    /* der Schatten kennt den Sollzustand: Zeilen einfach neu senden */
+    XHC_Shadow_InvalidateRows(s_heal_y, XHC_HEAL_ROWS);
+    XHC_Shadow_Flush();
+#else
+    XHC_Strip_Render(0, s_heal_y, LCD_W, XHC_HEAL_ROWS, WHITE, Render_Heal, NULL);
+#endif
+
+    s_heal_y = (uint16_t)(s_heal_y + XHC_HEAL_ROWS);
+    if (s_heal_y >= LCD_H) s_heal_y = 0;
+}
+#endif
 
 /* ===================== Public API ===================== */
 
@@ -449,31 +741,134 @@ void RenderScreen_Init(void)
     memset(s_last_bot, 0, sizeof(s_last_bot));
     memset(s_last_bot_len, 0, sizeof(s_last_bot_len));
     s_static_drawn = 0;
+    XHC_Proto_Reset(&s_ms);
+    XHC_Est_Reset();
+    XHC_Layout_Compute(&s_lay, XHC_DISPLAY_AXES ? XHC_DISPLAY_AXES : XHC_PROTO_AXES, LCD_W, s_blue_y);
+    XHC_Strip_Init();
+    s_zoom = -2;                      /* erzwingt Übernahme unten */
+    RenderScreen_SetZoom(XHC_ZOOM_AXIS);
+}
+
+void RenderScreen_SetZoom(int8_t idx)
+{
+    if (idx >= (int8_t)s_lay.fields) idx = (int8_t)(s_lay.fields - 1u);
+    if (idx < -1) idx = -1;
+    if (idx == s_zoom) return;
+    s_zoom = idx;
+    RenderScreen_Restore();
+}
+
+void RenderScreen_Restore(void)
+{
+    if (s_zoom >= 0){
+        XHC_Seg_Init(&s_zoom_field, 0, ZOOM_Y, ZOOM_DW, ZOOM_DH, ZOOM_CELLS, BLACK, WHITE);
+        s_zoom_field.x = (uint16_t)((LCD_W - XHC_Seg_Width(&s_zoom_field)) / 2u);  /* zentriert */
+    }
+
+    /* Layout komplett neu aufbauen, alle Caches verwerfen */
+    memset(s_last_val, 0, sizeof(s_last_val));
+    memset(s_last_len, 0, sizeof(s_last_len));
+    memset(s_last_bot, 0, sizeof(s_last_bot));
+    memset(s_last_bot_len, 0, sizeof(s_last_bot_len));
+    s_last_bar_val[0] = s_last_bar_val[1] = 0xFFFFu;
+    s_frame_dirty = DIRTY_ALL;
+    shown_source = 0;
+    s_static_drawn = 0;
+    XHC_Shadow_Invalidate();          /* Panel ist evtl. nicht mehr, was der Schatten glaubt */
     Draw_Static_Layout_Once();
 }
 
+void RenderScreen_SetAxes(uint8_t axes)
+{
+    XHC_Layout_Compute(&s_lay, axes, LCD_W, s_blue_y);
+    if (s_zoom >= (int8_t)s_lay.fields) s_zoom = -1;
+    RenderScreen_Restore();
+}
+
+uint8_t RenderScreen_Axes(void)
+{
+    return s_lay.axes;
+}
+
+void RenderScreen_SetRateLimit(uint16_t ms)
+{
+    s_min_period = ms;
+}
+
+uint16_t RenderScreen_RateLimit(void)
+{
+    return s_min_period;
+}
+
+static void Render_Update(void);
+
 void RenderScreen(void)
+{
+    /* Log-Seite offen: Panel gehört dem Log, Reports warten in der RX-Queue */
+    if (XHC_Display_LogActive()) return;
+
+#if XHC_HEAL
+    uint32_t t = t_last_draw;
+    Render_Update();
+    /* nichts Neues gezeichnet -> Budget für einen Heil-Streifen */
+    if (t_last_draw == t) Heal_Tick(HAL_GetTick());
+#else
+    Render_Update();
+#endif
+}
+
+static void Render_Update(void)
 {
     Draw_Static_Layout_Once();
 
     /* 1) Reports einsammeln */
     uint8_t rx[64]; uint16_t n=sizeof(rx);
+    uint8_t got = 0;                  /* Frame direkt im Cache aktualisiert */
     while (XHC_RX_TryPop(rx, &n)) {
         if (n>=8 && rx[0]==XHC_FEAT_ID){
             memcpy(live_payload, &rx[1], 7);
             have_live = 1;
-            asm_feed7(&rx[1]);   /* 37B-Assembler füttern */
+            asm_feed7(&rx[1]);   /* Frame-Assembler füttern */
+        } else if (n >= 1u + XHC_FRAME_SIZE && rx[0] == XHC_FRAME_OUT_ID){
+            /* Schnellmodus: ganzer Frame in einem Report über EP 0x01,
+               kein Zusammensetzen; direkt in den Cache, damit folgende
+               Deltas in derselben Runde darauf aufsetzen */
+            uint16_t changed;
+            if (XHC_Proto_DecodeHB04(&rx[1], XHC_FRAME_SIZE, &s_ms, &changed)){
+                memcpy(frame_cache, &rx[1], XHC_FRAME_SIZE);
+                have_base = 1;
+                Frame_Commit(1u, changed);
+                got = 1;
+            }
+        } else if (n >= 3u && rx[0] == XHC_DELTA_OUT_ID){
+            if (Apply_Delta(&rx[1], (uint16_t)(n - 1u))) got = 1;
+        } else if (n>=1 && rx[0]==XHC_SHOT_REQ_ID){
+            XHC_Shadow_RequestScreenshot();
         }
         n=sizeof(rx);
     }
 
-    uint32_t now = HAL_GetTick();
+    /* laufenden Screenshot stückweise über den IN-Endpoint schicken */
+    XHC_Shadow_ServiceScreenshot();
 
-    /* 2) 37B Frame fertig? -> cachen & „halten“ */
-    if (asm_len >= XHC_FRAME_SIZE){
-        memcpy(frame_cache, asm_buf, XHC_FRAME_SIZE);
-        have_frame = 1; frame_t = now; asm_reset();
+    uint32_t now = HAL_GetTick();
+    XHC_Est_Tick(XHC_Bench_Cycles());
+
+    /* 2) Frame der Variante fertig? -> dekodieren & „halten“ */
+    if (asm_len >= XHC_PROTO_FRAME_SIZE){
+        uint16_t changed;
+        if (XHC_Proto_Decode(asm_buf, XHC_PROTO_FRAME_SIZE, &s_ms, &changed)){
+#if XHC_PROTO == XHC_PROTO_HB04
+            /* gleiches Layout: auch Basis für folgende Deltas */
+            memcpy(frame_cache, asm_buf, XHC_FRAME_SIZE);
+            have_base = 1;
+#endif
+            Frame_Commit(0u, changed);
+            frame_t = now;
+        }
+        asm_reset();
     }
+    if (got) frame_t = now;
 
     /* 3) Quelle wählen (Frame bevorzugen, wenn frisch) */
     uint8_t want = 0;
@@ -482,57 +877,91 @@ void RenderScreen(void)
     else return;
 
     /* 4) Rate-Limit, aber nur wenn Quelle gleich bleibt */
-    if (want == shown_source && (now - t_last_draw) < UI_MIN_PERIOD_MS) return;
+    uint16_t period = s_min_period;
+#if XHC_INTERP
+    /* in Bewegung im Interpolationstakt; ein reiner Interpolationsschritt
+       wartet, bis der letzte Transfer durch ist */
+    if (want == 2 && (XHC_Est_Motion()->moving || s_interp_axes)){
+        if (XHC_INTERP_PERIOD_MS < period) period = XHC_INTERP_PERIOD_MS;
+        if (shown_source == 2 && !s_frame_dirty && ST7735_DMABusy()) return;
+    }
+#endif
+    if (want == shown_source && (now - t_last_draw) < period) return;
 
     /* 5) Rendern */
     if (want == 2){
-        /* ===== FRAME (37B) ===== */
-        whb04_out_data_t f; memcpy(&f, frame_cache, sizeof(f));
-        if (f.magic != XHC_MAGIC_LE){
-            if (!have_live) return;
-            want = 1;  /* auf Live umschalten */
-        } else {
-            char v[6][12];  /* 6 Werte je max 11 inkl. 0 */
-
-            /* exakt 10-stellig – Dezimalpunkte in einer Flucht */
-            xhc2string_align10(f.pos[0].p_int, f.pos[0].p_frac, v[0]);  /* Xw */
-            xhc2string_align10(f.pos[1].p_int, f.pos[1].p_frac, v[1]);  /* Yw */
-            xhc2string_align10(f.pos[2].p_int, f.pos[2].p_frac, v[2]);  /* Zw */
-            xhc2string_align10(f.pos[3].p_int, f.pos[3].p_frac, v[3]);  /* Xm */
-            xhc2string_align10(f.pos[4].p_int, f.pos[4].p_frac, v[4]);  /* Ym */
-            xhc2string_align10(f.pos[5].p_int, f.pos[5].p_frac, v[5]);  /* Zm */
-
-            /* ---- Footer: einfache Textwerte im blauen Balken ---- */
-            /* FEED: Hundertstel-% → auf ganze % runden und clampen 0..250 */
-            uint16_t feed_ovr_raw = rd16_le(frame_cache, OFF_FEED_OVR);
-            if (feed_ovr_raw > 25000u) feed_ovr_raw = 25000u;
-            uint16_t feed_pct = (uint16_t)((feed_ovr_raw + 50u) / 100u); /* 0..250 */
+        /* ===== FRAME (Maschinenzustand) ===== */
+        char v[XHC_LAYOUT_MAX_FIELDS][12];  /* je max 11 inkl. 0 */
+
+        /* nach Live-Anzeige/Restore ist der Bildschirm nicht mehr
+           der Frame-Stand: dann alles neu formatieren */
+        uint16_t dirty = (shown_source == 2) ? s_frame_dirty : DIRTY_ALL;
+#if XHC_INTERP
+        dirty |= Interp_Prepare();
+#endif
+        XHC_Tel_Log(TEL_RENDER_BEG, 2u, dirty);
+
+        /* exakt 10-stellig – Dezimalpunkte in einer Flucht;
+           nur Felder, die sich seit dem letzten Zeichnen geändert haben –
+           mehr Achsen kosten so nur Zeichenzeit, wenn sie sich bewegen */
+        uint16_t rows = 0;
+        for (uint8_t i=0; i<s_lay.fields; ++i){
+            if (dirty & Field_Bit(i)){
+                fixed4_align10(Field_Value(i), v[i]);
+                rows |= (uint16_t)(1u << i);
+            }
+        }
 
-            /* SPINDLE: ganzzahlig in % → clampen 50..150 */
-            uint16_t spin_pct = rd16_le(frame_cache, OFF_SPIND_OVR);
-            if (spin_pct < 50u)  spin_pct = 50u;
-            if (spin_pct > 150u) spin_pct = 150u;
+        /* ---- Footer: Overrides als Bars, 100% jeweils in der Mitte ---- */
+        /* FEED: clampen 0..250 */
+        uint16_t feed_pct = s_ms.feed_ovr;
+        if (feed_pct > 250u) feed_pct = 250u;
 
-            /* 100% liegt jeweils in der Mitte */
-            DrawBarValue(0, F_BAR_X, BARS_Y, F_BAR_W, BAR_H, feed_pct,  0u, 250u);
-            DrawBarValue(1, S_BAR_X, BARS_Y, S_BAR_W, BAR_H, spin_pct, 50u, 150u);
+        /* SPINDLE: clampen 50..150 */
+        uint16_t spin_pct = s_ms.spindle_ovr;
+        if (spin_pct < 50u)  spin_pct = 50u;
+        if (spin_pct > 150u) spin_pct = 150u;
 
+        DrawBarValue(0, F_BAR_X, BARS_Y, F_BAR_W, BAR_H, feed_pct,  0u, 250u);
+        DrawBarValue(1, S_BAR_X, BARS_Y, S_BAR_W, BAR_H, spin_pct, 50u, 150u);
+#if XHC_ESTIMATOR
+        Draw_Motion();
+#endif
 
-            for (uint8_t i=0; i<6; ++i) Draw_Value_Aligned(i, v[i]);
 
-            shown_source = 2; t_last_draw = now; return;
+        if (s_zoom >= 0){
+            if (rows & (1u << s_zoom)){
+                XHC_Seg_Draw(&s_zoom_field, v[s_zoom]);
+                XHC_Shadow_Flush();
+            }
+        } else {
+            for (uint8_t i=0; i<s_lay.fields; ++i){
+                if (rows & (1u << i)) Draw_Value_Aligned(i, v[i]);
+            }
         }
+
+        if (!s_dro_marked){ s_dro_marked = 1; XHC_Boot_Mark("dro"); }
+        XHC_Tel_Log(TEL_RENDER_END, 2u, rows);
+        s_frame_dirty = 0;
+        shown_source = 2; t_last_draw = now; return;
     }
 
     /* ===== LIVE (0x06) ===== */
     if (want == 1){
+        XHC_Tel_Log(TEL_RENDER_BEG, 1u, 0u);
         char num[16];
         feat06_to_text_align10(live_payload, num, sizeof(num));
 
         /* Zeige Live ersatzweise in der ersten Zeile (Xw) */
-        Draw_Value_Aligned(0, num);
+        if (s_zoom == 0){
+            XHC_Seg_Draw(&s_zoom_field, num);
+            XHC_Shadow_Flush();
+        } else if (s_zoom < 0){
+            Draw_Value_Aligned(0, num);
+        }
 
         /* die übrigen Zeilen werden nicht angerührt */
+        XHC_Tel_Log(TEL_RENDER_END, 1u, 0x01u);
         shown_source = 1; t_last_draw = now; return;
     }
 }
@@ -0,0 +1,118 @@
+/*
+ * xhc_seg.c
+ *
+ *  Created on: Oct 18, 2026
+ *      7-Segment-Ziffern aus Rechtecken (siehe xhc_seg.h)
+ */
+
+#include <string.h>
+#include "xhc_seg.h"
+#include "ST7735.h"
+#include "xhc_strip.h"
+
+/* Standard-Segmentmuster 0..9 */
+static const uint8_t s_digit_mask[10] = {
+    0x3Fu, 0x06u, 0x5Bu, 0x4Fu, 0x66u, 0x6Du, 0x7Du, 0x07u, 0x7Fu, 0x6Fu
+};
+
+uint8_t XHC_Seg_Mask(char c)
+{
+    if (c >= '0' && c <= '9') return s_digit_mask[c - '0'];
+    if (c == '-') return XHC_SEG_G;
+    if (c == '#') return (uint8_t)(XHC_SEG_A | XHC_SEG_G | XHC_SEG_D);  /* Überlauf */
+    return 0u;
+}
+
+void XHC_Seg_Init(XHC_SegField *f, uint16_t x, uint16_t y, uint8_t w, uint8_t h,
+                  uint8_t cells, uint16_t fg, uint16_t bg)
+{
+    f->x = x; f->y = y; f->w = w; f->h = h;
+    f->t = (uint8_t)((w >= 8u) ? (w / 4u) : 2u);
+    f->pitch = (uint8_t)(w + f->t + 2u);   /* Punkt + je 1 px Luft */
+    f->cells = (cells > XHC_SEG_MAX_CELLS) ? (uint8_t)XHC_SEG_MAX_CELLS : cells;
+    f->fg = fg; f->bg = bg;
+    memset(f->mask, 0, sizeof(f->mask));
+}
+
+uint16_t XHC_Seg_Width(const XHC_SegField *f)
+{
+    return (uint16_t)(f->cells * f->pitch);
+}
+
+void XHC_Seg_Clear(XHC_SegField *f)
+{
+    ST7735_FillRectangle(f->x, f->y, XHC_Seg_Width(f), f->h, f->bg);
+    memset(f->mask, 0, sizeof(f->mask));
+}
+
+/* Rechteck eines Segments relativ zur Zelle. Die Segmente überlappen sich
+   nicht (Ecken bleiben frei), ein ausgeschaltetes Segment löscht also nie
+   einen Nachbarn mit. */
+static void seg_rect(const XHC_SegField *f, uint8_t bit,
+                     uint8_t *x, uint8_t *y, uint8_t *w, uint8_t *h)
+{
+    uint8_t t  = f->t;
+    uint8_t m  = (uint8_t)((f->h - t) / 2u);        /* obere Kante von g */
+    uint8_t hw = (uint8_t)(f->w - 2u*t);            /* waagerechte Länge */
+    uint8_t hu = (uint8_t)(m - t);                  /* obere senkrechte */
+    uint8_t hl = (uint8_t)(f->h - 2u*t - m);        /* untere senkrechte */
+
+    switch (bit){
+    case XHC_SEG_A:  *x = t;              *y = 0;                 *w = hw; *h = t;  break;
+    case XHC_SEG_B:  *x = (uint8_t)(f->w - t); *y = t;            *w = t;  *h = hu; break;
+    case XHC_SEG_C:  *x = (uint8_t)(f->w - t); *y = (uint8_t)(m + t); *w = t; *h = hl; break;
+    case XHC_SEG_D:  *x = t;              *y = (uint8_t)(f->h - t); *w = hw; *h = t; break;
+    case XHC_SEG_E:  *x = 0;              *y = (uint8_t)(m + t);  *w = t;  *h = hl; break;
+    case XHC_SEG_F:  *x = 0;              *y = t;                 *w = t;  *h = hu; break;
+    case XHC_SEG_G:  *x = t;              *y = m;                 *w = hw; *h = t;  break;
+    default:         *x = (uint8_t)(f->w + 1u); *y = (uint8_t)(f->h - t); *w = t; *h = t; break;
+    }
+}
+
+static void draw_cell(XHC_SegField *f, uint8_t i, uint8_t mask)
+{
+    uint8_t diff = (uint8_t)(f->mask[i] ^ mask);
+    if (!diff) return;
+
+    uint16_t cx = (uint16_t)(f->x + i * f->pitch);
+    for (uint8_t bit = 0x01u; bit; bit <<= 1){
+        if (!(diff & bit)) continue;
+        uint8_t x, y, w, h;
+        seg_rect(f, bit, &x, &y, &w, &h);
+        if (!w || !h) continue;
+        ST7735_FillRectangle((uint16_t)(cx + x), (uint16_t)(f->y + y), w, h,
+                             (mask & bit) ? f->fg : f->bg);
+    }
+    f->mask[i] = mask;
+}
+
+void XHC_Seg_Strip(const XHC_SegField *f)
+{
+    for (uint8_t i = 0; i < f->cells; ++i){
+        int16_t cx = (int16_t)(f->x + i * f->pitch);
+        for (uint8_t bit = 0x01u; bit; bit <<= 1){
+            if (!(f->mask[i] & bit)) continue;
+            uint8_t x, y, w, h;
+            seg_rect(f, bit, &x, &y, &w, &h);
+            XHC_Strip_FillRect((int16_t)(cx + x), (int16_t)(f->y + y), w, h, f->fg);
+        }
+    }
+}
+
+void XHC_Seg_Draw(XHC_SegField *f, const char *s)
+{
+    uint8_t want[XHC_SEG_MAX_CELLS];
+    uint8_t n = 0;
+
+    memset(want, 0, sizeof(want));
+    for (; *s; ++s){
+        if (*s == '.'){
+            if (n) want[n - 1u] |= XHC_SEG_DP;
+            continue;
+        }
+        if (n >= f->cells) break;
+        want[n++] = XHC_Seg_Mask(*s);
+    }
+
+    for (uint8_t i = 0; i < f->cells; ++i) draw_cell(f, i, want[i]);
+}
@@ -0,0 +1,239 @@
+/*
+ * xhc_shadow.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "xhc_shadow.h"
+
+#if XHC_SHADOW_FB
+
+#include <string.h>
+#include "ST7735.h"
+#include "usbd_custom_hid_if.h"   // XHC_TX_Send
+
+/* 4bpp-Bild: Zeile für Zeile, gerades x im oberen Nibble */
+static uint8_t  s_fb[XHC_SHADOW_BYTES];
+
+/* Dirty-Span je Zeile (x0 > x1 = sauber) */
+static uint8_t  s_dx0[XHC_SHADOW_H];
+static uint8_t  s_dx1[XHC_SHADOW_H];
+
+/* Palette: die festen UI-Farben zuerst, Rest wird bei Bedarf belegt */
+static uint16_t s_pal[16] = { WHITE, BLACK, BLUE, RED, GREEN, CYAN, YELLOW, MAGENTA };
+static uint8_t  s_pal_n   = 8;
+
+/* RGB565-Zeilenpuffer für den Flush, zwei im Wechsel (einer läuft per DMA) */
+static uint16_t s_line[2][XHC_SHADOW_LINE_PIXELS];
+static uint8_t  s_line_cur = 0;
+
+/* Screenshot-Zustand: 0xFFFF = Palette als nächstes, sonst Byte-Offset */
+static uint8_t  s_shot_active = 0;
+static uint16_t s_shot_off    = 0;
+static uint8_t  s_shot_rep[64];
+
+static inline void mark_dirty(uint16_t x, uint16_t y)
+{
+    if (x < s_dx0[y]) s_dx0[y] = (uint8_t)x;
+    if (x > s_dx1[y]) s_dx1[y] = (uint8_t)x;
+}
+
+static inline uint8_t get_px(uint16_t x, uint16_t y)
+{
+    uint8_t b = s_fb[y * (XHC_SHADOW_W/2u) + (x >> 1)];
+    return (x & 1u) ? (uint8_t)(b & 0x0Fu) : (uint8_t)(b >> 4);
+}
+
+/* Pixel setzen, nur bei echter Änderung dirty markieren */
+static inline void set_px(uint16_t x, uint16_t y, uint8_t idx)
+{
+    uint8_t *p = &s_fb[y * (XHC_SHADOW_W/2u) + (x >> 1)];
+    uint8_t  v = (x & 1u) ? (uint8_t)((*p & 0xF0u) | idx)
+                          : (uint8_t)((*p & 0x0Fu) | (uint8_t)(idx << 4));
+    if (v != *p){
+        *p = v;
+        mark_dirty(x, y);
+    }
+}
+
+void XHC_Shadow_Init(void)
+{
+    memset(s_fb, 0, sizeof(s_fb));   /* Index 0 = WHITE */
+    XHC_Shadow_Invalidate();
+    s_shot_active = 0;
+}
+
+void XHC_Shadow_Invalidate(void)
+{
+    XHC_Shadow_InvalidateRows(0, XHC_SHADOW_H);
+}
+
+void XHC_Shadow_InvalidateRows(uint16_t y, uint16_t h)
+{
+    for (uint16_t r = y; r < y + h && r < XHC_SHADOW_H; ++r){
+        s_dx0[r] = 0;
+        s_dx1[r] = (uint8_t)(XHC_SHADOW_W - 1u);
+    }
+}
+
+uint8_t XHC_Shadow_Index(uint16_t color)
+{
+    for (uint8_t i = 0; i < s_pal_n; ++i){
+        if (s_pal[i] == color) return i;
+    }
+    if (s_pal_n < 16u){
+        s_pal[s_pal_n] = color;
+        return s_pal_n++;
+    }
+
+    /* Palette voll: nächstliegende Farbe (quadratischer Abstand in 5/6/5) */
+    uint8_t  best = 0;
+    uint32_t bestd = 0xFFFFFFFFu;
+    for (uint8_t i = 0; i < 16u; ++i){
+        int32_t dr = (int32_t)(s_pal[i] >> 11)          - (int32_t)(color >> 11);
+        int32_t dg = (int32_t)((s_pal[i] >> 5) & 0x3Fu) - (int32_t)((color >> 5) & 0x3Fu);
+        int32_t db = (int32_t)(s_pal[i] & 0x1Fu)        - (int32_t)(color & 0x1Fu);
+        uint32_t d = (uint32_t)(4*dr*dr + dg*dg + 4*db*db);
+        if (d < bestd){ bestd = d; best = i; }
+    }
+    return best;
+}
+
+uint16_t XHC_Shadow_Color(uint8_t idx)
+{
+    return s_pal[idx & 0x0Fu];
+}
+
+void XHC_Shadow_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    if (x < 0){ w = (int16_t)(w + x); x = 0; }
+    if (y < 0){ h = (int16_t)(h + y); y = 0; }
+    if (x + w > (int16_t)XHC_SHADOW_W) w = (int16_t)(XHC_SHADOW_W - x);
+    if (y + h > (int16_t)XHC_SHADOW_H) h = (int16_t)(XHC_SHADOW_H - y);
+    if (w <= 0 || h <= 0) return;
+
+    uint8_t idx = XHC_Shadow_Index(color);
+    for (int16_t yy = y; yy < y + h; ++yy){
+        for (int16_t xx = x; xx < x + w; ++xx) set_px((uint16_t)xx, (uint16_t)yy, idx);
+    }
+}
+
+void XHC_Shadow_DrawChar(int16_t x, int16_t y, char ch, FontDef font, uint16_t fg, uint16_t bg)
+{
+    uint8_t ifg = XHC_Shadow_Index(fg);
+    uint8_t ibg = XHC_Shadow_Index(bg);
+    const uint8_t *g = Font_Glyph(&font, ch);
+    uint8_t m = 0x80u;
+
+    /* Bitstrom läuft zeilenweise durch, auch über geclippte Pixel */
+    for (int16_t r = 0; r < font.height; ++r){
+        int16_t yy = (int16_t)(y + r);
+        for (int16_t c = 0; c < font.width; ++c){
+            int16_t xx = (int16_t)(x + c);
+            uint8_t on = (*g & m) != 0;
+            if (!(m >>= 1)) { m = 0x80u; ++g; }
+            if (yy < 0 || yy >= (int16_t)XHC_SHADOW_H) continue;
+            if (xx < 0 || xx >= (int16_t)XHC_SHADOW_W) continue;
+            set_px((uint16_t)xx, (uint16_t)yy, on ? ifg : ibg);
+        }
+    }
+}
+
+void XHC_Shadow_DrawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *data)
+{
+    for (int16_t r = 0; r < h; ++r){
+        for (int16_t c = 0; c < w; ++c){
+            int16_t xx = (int16_t)(x + c), yy = (int16_t)(y + r);
+            if (xx < 0 || yy < 0 || xx >= (int16_t)XHC_SHADOW_W || yy >= (int16_t)XHC_SHADOW_H) continue;
+            /* DrawImage-Daten liegen wie für den Bus byte-getauscht vor */
+            set_px((uint16_t)xx, (uint16_t)yy, XHC_Shadow_Index(ST7735_WIRE16(data[r*w + c])));
+        }
+    }
+}
+
+void XHC_Shadow_CommitBand(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t *idx)
+{
+    for (uint16_t r = 0; r < h; ++r){
+        for (uint16_t c = 0; c < w; ++c){
+            set_px((uint16_t)(x + c), (uint16_t)(y + r), *idx++);
+        }
+    }
+}
+
+void XHC_Shadow_Flush(void)
+{
+    uint16_t wire[16];
+    for (uint8_t i = 0; i < 16u; ++i) wire[i] = ST7735_WIRE16(s_pal[i]);
+
+    uint16_t y = 0;
+    while (y < XHC_SHADOW_H){
+        uint8_t x0 = s_dx0[y], x1 = s_dx1[y];
+        if (x0 > x1){ ++y; continue; }
+
+        /* Folgezeilen mit identischem Span in dasselbe Fenster packen */
+        uint16_t w  = (uint16_t)(x1 - x0 + 1u);
+        uint16_t y1 = (uint16_t)(y + 1u);
+        while (y1 < XHC_SHADOW_H && s_dx0[y1] == x0 && s_dx1[y1] == x1
+               && (uint32_t)(y1 - y + 1u) * w <= XHC_SHADOW_LINE_PIXELS) ++y1;
+
+        /* der andere Puffer kann noch laufen, dieser ist frei */
+        uint16_t *buf = s_line[s_line_cur];
+        uint16_t *p   = buf;
+        for (uint16_t r = y; r < y1; ++r){
+            for (uint16_t c = x0; c <= x1; ++c) *p++ = wire[get_px(c, r)];
+            s_dx0[r] = 0xFFu;
+            s_dx1[r] = 0u;
+        }
+        ST7735_DrawImageDMA(x0, y, w, (uint16_t)(y1 - y), (const uint8_t*)buf);
+        s_line_cur ^= 1u;
+        y = y1;
+    }
+}
+
+void XHC_Shadow_RequestScreenshot(void)
+{
+    s_shot_active = 1;
+    s_shot_off    = XHC_SHOT_PALETTE;
+}
+
+void XHC_Shadow_ServiceScreenshot(void)
+{
+    if (!s_shot_active) return;
+
+    uint8_t n;
+    s_shot_rep[0] = XHC_SHOT_DATA_ID;
+    s_shot_rep[1] = (uint8_t)(s_shot_off & 0xFFu);
+    s_shot_rep[2] = (uint8_t)(s_shot_off >> 8);
+    if (s_shot_off == XHC_SHOT_PALETTE){
+        n = 32u;
+        for (uint8_t i = 0; i < 16u; ++i){
+            s_shot_rep[4 + 2*i]     = (uint8_t)(s_pal[i] & 0xFFu);
+            s_shot_rep[4 + 2*i + 1] = (uint8_t)(s_pal[i] >> 8);
+        }
+    } else {
+        uint16_t rest = (uint16_t)(XHC_SHADOW_BYTES - s_shot_off);
+        n = (uint8_t)((rest < XHC_SHOT_CHUNK) ? rest : XHC_SHOT_CHUNK);
+        memcpy(&s_shot_rep[4], &s_fb[s_shot_off], n);
+    }
+    s_shot_rep[3] = n;
+
+    /* IN-Endpoint belegt -> nächster Durchlauf */
+    if (!XHC_TX_Send(s_shot_rep, 64u)) return;
+
+    if (s_shot_off == XHC_SHOT_PALETTE) s_shot_off = 0;
+    else                                s_shot_off = (uint16_t)(s_shot_off + n);
+    if (s_shot_off != XHC_SHOT_PALETTE && s_shot_off >= XHC_SHADOW_BYTES) s_shot_active = 0;
+}
+
+#else  /* !XHC_SHADOW_FB */
+
+/* ohne Schattenpuffer: Aufrufer brauchen kein eigenes #if,
+   Screenshot-Anforderungen laufen ins Leere */
+void XHC_Shadow_Init(void) { }
+void XHC_Shadow_Flush(void) { }
+void XHC_Shadow_Invalidate(void) { }
+void XHC_Shadow_InvalidateRows(uint16_t y, uint16_t h) { (void)y; (void)h; }
+void XHC_Shadow_RequestScreenshot(void) { }
+void XHC_Shadow_ServiceScreenshot(void) { }
+
+#endif /* XHC_SHADOW_FB */
@@ -0,0 +1,84 @@
+/*
+ * xhc_sof.c
+ *
+ *  Created on: Oct 18, 2026
+ *      SOF-Taktgeber (siehe xhc_sof.h)
+ */
+
+#include "xhc_sof.h"
+#include "xhc_bench.h"
+#include "stm32f1xx_hal.h"
+
+/* so lange ohne SOF gilt der Bus als still (Suspend, abgesteckt) */
+#define SOF_TIMEOUT_MS  3u
+
+static volatile uint32_t s_count;
+static volatile uint32_t s_cyc;       /* DWT-Stand beim letzten SOF */
+static volatile uint32_t s_tick;      /* HAL_GetTick beim letzten SOF */
+static volatile uint16_t s_frame;
+static uint32_t          s_seen;      /* zuletzt von XHC_Sof_Wait gesehenes SOF */
+static XHC_SofStats      s_stats = { 0, 0, 0xFFFFFFFFu, 0, 0 };
+
+__attribute__((weak)) void XHC_Sof_Stage(uint16_t frame)
+{
+    (void)frame;
+}
+
+void XHC_Sof_Irq(void)
+{
+    uint32_t cyc   = XHC_Bench_Cycles();
+    uint16_t frame = (uint16_t)(USB->FNR & USB_FNR_FN);
+
+    if (s_count != 0u){
+        uint32_t d = cyc - s_cyc;
+        uint16_t step = (uint16_t)((frame - s_frame) & USB_FNR_FN);
+        if (step == 1u){
+            /* Abstand nur über direkt aufeinanderfolgende Frames werten */
+            if (d < s_stats.period_min) s_stats.period_min = d;
+            if (d > s_stats.period_max) s_stats.period_max = d;
+        } else {
+            s_stats.missed += (uint32_t)(step - 1u);
+        }
+    }
+    s_cyc   = cyc;
+    s_tick  = HAL_GetTick();
+    s_frame = frame;
+    s_count = s_count + 1u;
+
+    XHC_Sof_Stage(frame);
+}
+
+uint8_t XHC_Sof_Active(void)
+{
+    return (s_count != 0u && (HAL_GetTick() - s_tick) < SOF_TIMEOUT_MS) ? 1u : 0u;
+}
+
+void XHC_Sof_Wait(void)
+{
+#if XHC_SOF_SYNC
+    if (XHC_Sof_Active()){
+        /* schon ein SOF weiter als beim letzten Mal: Schleife war zu lang */
+        if (s_count - s_seen > 1u) ++s_stats.loop_late;
+        uint32_t t0 = HAL_GetTick();
+        while (s_count == s_seen && (HAL_GetTick() - t0) < SOF_TIMEOUT_MS){
+            __WFI();                  /* SOF- oder SysTick-IRQ weckt */
+        }
+        s_seen = s_count;
+        return;
+    }
+#endif
+    s_seen = s_count;
+    HAL_Delay(1);
+}
+
+uint32_t XHC_Sof_Age(void)
+{
+    return XHC_Bench_Cycles() - s_cyc;
+}
+
+void XHC_Sof_GetStats(XHC_SofStats *out)
+{
+    if (!out) return;
+    *out = s_stats;
+    out->count = s_count;
+}
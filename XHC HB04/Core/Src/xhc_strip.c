@@ -0,0 +1,195 @@
+/*
+ * xhc_strip.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <string.h>
+#include "xhc_strip.h"
+#include "xhc_config.h"
+#include "ST7735.h"
+#include "xhc_shadow.h"
+
+extern int16_t _width;
+extern int16_t _height;
+
+#if XHC_SHADOW_FB
+/* Schattenbetrieb: ein Index-Band, Commit in den 4bpp-Puffer (nur Diffs) */
+typedef uint8_t  strip_px_t;
+#define STRIP_PX(c)    XHC_Shadow_Index(c)
+#define STRIP_PIXELS   XHC_SHADOW_BAND_PIXELS
+#define STRIP_BANDS    1u
+#else
+/* Pixel schon in Übertragungs-Byteorder (ST7735_WIRE16) */
+typedef uint16_t strip_px_t;
+#define STRIP_PX(c)    ST7735_WIRE16(c)
+#define STRIP_PIXELS   XHC_STRIP_PIXELS
+#define STRIP_BANDS    XHC_STRIP_BANDS
+#endif
+
+/* Bandpuffer */
+static strip_px_t s_band[STRIP_BANDS][STRIP_PIXELS];
+static uint8_t    s_cur = 0;
+
+/* aktuelles Band = Clip-Fenster in Bildschirmkoordinaten */
+static strip_px_t *s_px = 0;
+static int16_t   s_bx, s_by, s_bw, s_bh;
+
+void XHC_Strip_Init(void)
+{
+    ST7735_WaitDMA();
+    s_cur = 0;
+    s_px  = 0;
+}
+
+void XHC_Strip_Render(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                      uint16_t bg, XHC_StripRenderFn fn, void *ctx)
+{
+    if (!fn || x >= (uint16_t)_width || y >= (uint16_t)_height) return;
+    if (x + w > (uint16_t)_width)  w = (uint16_t)(_width  - x);
+    if (y + h > (uint16_t)_height) h = (uint16_t)(_height - y);
+    if (!w || !h || w > STRIP_PIXELS) return;
+
+    uint16_t   rows = (uint16_t)(STRIP_PIXELS / w);
+    strip_px_t wbg  = STRIP_PX(bg);
+
+    for (uint16_t y0 = y; y0 < y + h; y0 += rows) {
+        uint16_t bh = (uint16_t)((y + h - y0 < rows) ? (y + h - y0) : rows);
+
+        /* Mit nur einem Band muss der letzte Transfer erst durch sein;
+           bei zwei Bändern läuft höchstens das jeweils andere noch. */
+        if (STRIP_BANDS < 2u) ST7735_WaitDMA();
+
+        s_px = s_band[s_cur];
+        s_bx = (int16_t)x; s_by = (int16_t)y0;
+        s_bw = (int16_t)w; s_bh = (int16_t)bh;
+
+        uint32_t n = (uint32_t)w * bh;
+        for (uint32_t i = 0; i < n; ++i) s_px[i] = wbg;
+
+        fn(ctx);
+
+#if XHC_SHADOW_FB
+        XHC_Shadow_CommitBand(x, y0, w, bh, s_px);
+#else
+        /* wartet selbst auf das vorige Band, startet dann dieses */
+        ST7735_DrawImageDMA(x, y0, w, bh, (const uint8_t*)s_px);
+#endif
+        s_cur = (uint8_t)((s_cur + 1u) % STRIP_BANDS);
+    }
+    s_px = 0;
+
+#if XHC_SHADOW_FB
+    XHC_Shadow_Flush();
+#endif
+}
+
+void XHC_Strip_Image(uint16_t x, uint16_t y, const XHC_RleImage *img)
+{
+    uint16_t w = img->w, h = img->h;
+    if (!w || w > STRIP_PIXELS || x + w > (uint16_t)_width || y + h > (uint16_t)_height) return;
+
+    strip_px_t pal[16];
+    for (uint8_t i = 0; i < 16u; ++i) pal[i] = STRIP_PX(img->palette[i < img->ncolors ? i : 0]);
+
+    const uint8_t *src = img->data;
+    const uint8_t *end = img->data + img->size;
+    strip_px_t c   = pal[0];
+    uint16_t   run = 0;
+    uint16_t   rows = (uint16_t)(STRIP_PIXELS / w);
+
+    for (uint16_t y0 = y; y0 < y + h; y0 += rows) {
+        uint16_t bh = (uint16_t)((y + h - y0 < rows) ? (y + h - y0) : rows);
+
+        if (STRIP_BANDS < 2u) ST7735_WaitDMA();
+
+        /* Läufe gehen über Zeilen- und Bandgrenzen hinweg */
+        strip_px_t *p = s_band[s_cur];
+        uint32_t n = (uint32_t)w * bh;
+        while (n) {
+            if (!run) {
+                if (src >= end) { run = 0xFFFFu; c = pal[0]; }   /* kaputtes Bild: Rest Farbe 0 */
+                else {
+                    uint8_t b = *src++;
+                    c   = pal[b >> 4];
+                    run = (uint16_t)((b & 0x0Fu) + 1u);
+                    if (run == 16u && src < end) run = (uint16_t)(16u + *src++);
+                }
+            }
+            uint16_t k = (run < n) ? run : (uint16_t)n;
+            n -= k; run = (uint16_t)(run - k);
+            while (k--) *p++ = c;
+        }
+
+#if XHC_SHADOW_FB
+        XHC_Shadow_CommitBand(x, y0, w, bh, s_band[s_cur]);
+#else
+        ST7735_DrawImageDMA(x, y0, w, bh, (const uint8_t*)s_band[s_cur]);
+#endif
+        s_cur = (uint8_t)((s_cur + 1u) % STRIP_BANDS);
+    }
+
+#if XHC_SHADOW_FB
+    XHC_Shadow_Flush();
+#endif
+}
+
+void XHC_Strip_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    if (!s_px || w <= 0 || h <= 0) return;
+
+    int16_t x0 = (x > s_bx) ? x : s_bx;
+    int16_t y0 = (y > s_by) ? y : s_by;
+    int16_t x1 = (x + w < s_bx + s_bw) ? (int16_t)(x + w) : (int16_t)(s_bx + s_bw);
+    int16_t y1 = (y + h < s_by + s_bh) ? (int16_t)(y + h) : (int16_t)(s_by + s_bh);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    strip_px_t wc = STRIP_PX(color);
+    for (int16_t yy = y0; yy < y1; ++yy) {
+        strip_px_t *p = &s_px[(yy - s_by) * s_bw + (x0 - s_bx)];
+        for (int16_t xx = x0; xx < x1; ++xx) *p++ = wc;
+    }
+}
+
+void XHC_Strip_DrawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    XHC_Strip_FillRect(x, y, w, 1, color);
+    XHC_Strip_FillRect(x, (int16_t)(y + h - 1), w, 1, color);
+    XHC_Strip_FillRect(x, y, 1, h, color);
+    XHC_Strip_FillRect((int16_t)(x + w - 1), y, 1, h, color);
+}
+
+void XHC_Strip_DrawChar(int16_t x, int16_t y, char ch, FontDef font, uint16_t fg, uint16_t bg)
+{
+    if (!s_px) return;
+    /* sichtbarer Ausschnitt der Glyphe im aktuellen Band */
+    int16_t r0 = (s_by > y) ? (int16_t)(s_by - y) : 0;
+    int16_t r1 = (y + font.height > s_by + s_bh) ? (int16_t)(s_by + s_bh - y) : (int16_t)font.height;
+    int16_t c0 = (s_bx > x) ? (int16_t)(s_bx - x) : 0;
+    int16_t c1 = (x + font.width > s_bx + s_bw) ? (int16_t)(s_bx + s_bw - x) : (int16_t)font.width;
+    if (r0 >= r1 || c0 >= c1) return;
+
+    strip_px_t wfg = STRIP_PX(fg);
+    strip_px_t wbg = STRIP_PX(bg);
+    const uint8_t *g = Font_Glyph(&font, ch);
+
+    for (int16_t r = r0; r < r1; ++r) {
+        /* Bitstrom: Pixel (r,c0) liegt bei Bit r*width+c0 der Glyphe */
+        uint16_t bit = (uint16_t)(r * font.width + c0);
+        const uint8_t *b = &g[bit >> 3];
+        uint8_t m = (uint8_t)(0x80u >> (bit & 7u));
+        strip_px_t *p = &s_px[(y + r - s_by) * s_bw + (x + c0 - s_bx)];
+        for (int16_t c = c0; c < c1; ++c) {
+            *p++ = (*b & m) ? wfg : wbg;
+            if (!(m >>= 1)) { m = 0x80u; ++b; }
+        }
+    }
+}
+
+void XHC_Strip_DrawString(int16_t x, int16_t y, const char *s, FontDef font, uint16_t fg, uint16_t bg)
+{
+    while (*s) {
+        XHC_Strip_DrawChar(x, y, *s++, font, fg, bg);
+        x = (int16_t)(x + font.width);
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * xhc_telemetry.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Binäre Laufzeit-Telemetrie (siehe xhc_telemetry.h)
+ */
+
+#include <string.h>
+#include "xhc_telemetry.h"
+
+#if XHC_TELEMETRY
+
+#include "xhc_bench.h"
+#include "usbd_cdc_acm.h"
+
+#define TEL_SYNC0        0xA5u
+#define TEL_SYNC1        0x5Au
+#define TEL_PKT_RECORDS  15u   /* 4 + 15*8 + 1 = 125 Byte je Paket */
+
+static XHC_TelRecord     s_ring[XHC_TELEMETRY_RECORDS];
+static volatile uint16_t s_head, s_tail;
+static volatile uint32_t s_lost_pending;
+static uint32_t          s_logged, s_lost;
+static uint8_t           s_on;
+static uint8_t           s_seq;
+
+#define TEL_NEXT(i)  (uint16_t)(((i) + 1u) % XHC_TELEMETRY_RECORDS)
+
+void XHC_Tel_Log(uint8_t type, uint8_t a8, uint16_t a16)
+{
+    if (!s_on) return;
+
+    uint32_t cyc = XHC_Bench_Cycles();
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint16_t h = s_head;
+    /* Verlust nachtragen, sobald wieder zwei Plätze frei sind */
+    if (s_lost_pending && TEL_NEXT(h) != s_tail && TEL_NEXT(TEL_NEXT(h)) != s_tail){
+        XHC_TelRecord *r = &s_ring[h];
+        r->cyc = cyc; r->type = TEL_LOST; r->a8 = 0;
+        r->a16 = (s_lost_pending > 0xFFFFu) ? 0xFFFFu : (uint16_t)s_lost_pending;
+        s_lost_pending = 0;
+        h = TEL_NEXT(h);
+    }
+    if (TEL_NEXT(h) == s_tail){
+        ++s_lost_pending; ++s_lost;
+    } else {
+        XHC_TelRecord *r = &s_ring[h];
+        r->cyc = cyc; r->type = type; r->a8 = a8; r->a16 = a16;
+        h = TEL_NEXT(h);
+        ++s_logged;
+    }
+    s_head = h;
+
+    __set_PRIMASK(primask);
+}
+
+void XHC_Tel_Drain(void)
+{
+    if (!s_on || !XHC_CDC_Connected()) return;
+
+    uint8_t pkt[4u + TEL_PKT_RECORDS * sizeof(XHC_TelRecord) + 1u];
+    while (s_tail != s_head){
+        /* nur ganze Pakete: nie warten, nie halbe Pakete in den Ring */
+        uint16_t avail = (uint16_t)((s_head + XHC_TELEMETRY_RECORDS - s_tail) % XHC_TELEMETRY_RECORDS);
+        uint16_t room  = XHC_CDC_TxFree();
+        if (room < 4u + sizeof(XHC_TelRecord) + 1u) return;
+        uint16_t n = (uint16_t)((room - 5u) / sizeof(XHC_TelRecord));
+        if (n > avail) n = avail;
+        if (n > TEL_PKT_RECORDS) n = TEL_PKT_RECORDS;
+
+        pkt[0] = TEL_SYNC0; pkt[1] = TEL_SYNC1;
+        pkt[2] = (uint8_t)n; pkt[3] = s_seq++;
+        uint16_t t = s_tail, len = 4u;
+        for (uint16_t i = 0; i < n; ++i){
+            memcpy(&pkt[len], &s_ring[t], sizeof(XHC_TelRecord));
+            len = (uint16_t)(len + sizeof(XHC_TelRecord));
+            t = TEL_NEXT(t);
+        }
+        uint8_t x = 0;
+        for (uint16_t i = 2u; i < len; ++i) x ^= pkt[i];
+        pkt[len++] = x;
+
+        XHC_CDC_Write(pkt, len);
+        s_tail = t;                   /* erst nach dem Kopieren freigeben */
+    }
+}
+
+void XHC_Tel_Enable(uint8_t on)
+{
+    /* mit frischem Ring starten, alte Ereignisse haben keinen Bezug */
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    s_tail = s_head;
+    s_lost_pending = 0;
+    s_on = on ? 1u : 0u;
+    __set_PRIMASK(primask);
+}
+
+uint8_t XHC_Tel_Enabled(void) { return s_on; }
+
+void XHC_Tel_GetStats(uint32_t *logged, uint32_t *lost)
+{
+    if (logged) *logged = s_logged;
+    if (lost)   *lost   = s_lost;
+}
+
+#endif /* XHC_TELEMETRY */
@@ -42,10 +42,10 @@ extern "C" {
   * @{
   */
 #define CUSTOM_HID_EPIN_ADDR                 0x81U
-#define CUSTOM_HID_EPIN_SIZE                 0x02U
+#define CUSTOM_HID_EPIN_SIZE                 0x40U
 
 #define CUSTOM_HID_EPOUT_ADDR                0x01U
-#define CUSTOM_HID_EPOUT_SIZE                0x02U
+#define CUSTOM_HID_EPOUT_SIZE                0x40U
 
 #define USB_CUSTOM_HID_CONFIG_DESC_SIZ       41U
 #define USB_CUSTOM_HID_DESC_SIZ              9U
@@ -97,12 +97,23 @@ typedef struct _USBD_CUSTOM_HID_Itf
   int8_t (* Init)(void);
   int8_t (* DeInit)(void);
   int8_t (* OutEvent)(uint8_t event_idx, uint8_t state);
+  /* optional (NULL): whole report from the interrupt OUT endpoint */
+  int8_t (* OutReport)(uint8_t *report, uint16_t len);
+  /* optional (NULL): GET_REPORT, returns the report (static) or NULL to stall */
+  uint8_t *(* GetReport)(uint8_t report_id, uint16_t *len);
 
 } USBD_CUSTOM_HID_ItfTypeDef;
 
 typedef struct
 {
   uint8_t              Report_buf[USBD_CUSTOMHID_OUTREPORT_BUF_SIZE];
+  /* EP OUT ping-pong: one buffer is armed while the other is being handled */
+  uint8_t              Out_buf[2][CUSTOM_HID_EPOUT_SIZE];
+  uint8_t              Out_idx;
+  /* EP IN: one report staged while the endpoint is busy, sent from DataIn */
+  uint8_t              In_buf[CUSTOM_HID_EPIN_SIZE];
+  uint16_t             In_len;
+  uint8_t              In_pending;
   uint32_t             Protocol;
   uint32_t             IdleState;
   uint32_t             AltSetting;
@@ -138,7 +138,7 @@ __ALIGN_BEGIN static uint8_t USBD_CUSTOM_HID_CfgFSDesc[USB_CUSTOM_HID_CONFIG_DES
 		  /* CONFIG DESCRIPTOR */
 		  0x09,	        /* bLength */
 		  0x02,	        /* bDescriptorType (Configuration)*/
-		  0x22, 0x00,	/* wTotalLength ( size of all structure ) */
+		  USB_CUSTOM_HID_CONFIG_DESC_SIZ, 0x00,	/* wTotalLength ( size of all structure ) */
 		  0x01,	        /* bNumInterfaces */
 		  0x01,	        /* bConfigurationValue */
 		  0x00,	        /* iConfiguration */
@@ -150,7 +150,7 @@ __ALIGN_BEGIN static uint8_t USBD_CUSTOM_HID_CfgFSDesc[USB_CUSTOM_HID_CONFIG_DES
 		  0x04,	        /* bDescriptorType (Interface)*/
 		  0x00,	        /* bInterfaceNumber */
 		  0x00,	        /* bAlternateSetting */
-		  0x01,	        /* bNumEndPoints */
+		  0x02,	        /* bNumEndPoints */
 		  0x03,	        /* bInterfaceClass (HID) */
 		  0x00,	        /* bInterfaceSubClass */
 		  0x00,	        /* bInterfaceProtocol */
@@ -163,7 +163,7 @@ __ALIGN_BEGIN static uint8_t USBD_CUSTOM_HID_CfgFSDesc[USB_CUSTOM_HID_CONFIG_DES
 		  0x00,         /* bCountryCode */
 		  0x01,         /* bNumDescriptors */
 		  0x22,         /* bDescriptorType ( Report ) */
-		  0x2E,0x00,    /* wDescriptorLength ( Report Size ) */
+		  USBD_CUSTOM_HID_REPORT_DESC_SIZE,0x00,    /* wDescriptorLength ( Report Size ) */
 
 		  /* ENDPOINT DESCRIPTOR */
 		  0x07,	        /* bLength */
@@ -172,6 +172,14 @@ __ALIGN_BEGIN static uint8_t USBD_CUSTOM_HID_CfgFSDesc[USB_CUSTOM_HID_CONFIG_DES
 		  0x03,	        /* bmAttributes	( Interrupt ) */
 		  0x40, 0x00,	/* wMaxPacketSize   (64 Bytes) */
 		  0x02,	        /* bInterval ( 2 ms )*/
+
+		  /* ENDPOINT DESCRIPTOR */
+		  0x07,	        /* bLength */
+		  0x05,	        /* bDescriptorType ( Endpoint )*/
+		  CUSTOM_HID_EPOUT_ADDR,	/* bEndpointAddress (OUT Endpoint 1) */
+		  0x03,	        /* bmAttributes	( Interrupt ) */
+		  CUSTOM_HID_EPOUT_SIZE, 0x00,	/* wMaxPacketSize   (64 Bytes) */
+		  0x01,	        /* bInterval ( 1 ms )*/
 };
 
 /* USB CUSTOM_HID device HS Configuration Descriptor */
@@ -180,7 +188,7 @@ __ALIGN_BEGIN static uint8_t USBD_CUSTOM_HID_CfgHSDesc[USB_CUSTOM_HID_CONFIG_DES
 		  /* CONFIG DESCRIPTOR */
 		  0x09,	        /* bLength */
 		  0x02,	        /* bDescriptorType (Configuration)*/
-		  0x22, 0x00,	/* wTotalLength ( size of all structure ) */
+		  USB_CUSTOM_HID_CONFIG_DESC_SIZ, 0x00,	/* wTotalLength ( size of all structure ) */
 		  0x01,	        /* bNumInterfaces */
 		  0x01,	        /* bConfigurationValue */
 		  0x00,	        /* iConfiguration */
@@ -192,7 +200,7 @@ __ALIGN_BEGIN static uint8_t USBD_CUSTOM_HID_CfgHSDesc[USB_CUSTOM_HID_CONFIG_DES
 		  0x04,	        /* bDescriptorType (Interface)*/
 		  0x00,	        /* bInterfaceNumber */
 		  0x00,	        /* bAlternateSetting */
-		  0x01,	        /* bNumEndPoints */
+		  0x02,	        /* bNumEndPoints */
 		  0x03,	        /* bInterfaceClass (HID) */
 		  0x00,	        /* bInterfaceSubClass */
 		  0x00,	        /* bInterfaceProtocol */
@@ -205,7 +213,7 @@ __ALIGN_BEGIN static uint8_t USBD_CUSTOM_HID_CfgHSDesc[USB_CUSTOM_HID_CONFIG_DES
 		  0x00,         /* bCountryCode */
 		  0x01,         /* bNumDescriptors */
 		  0x22,         /* bDescriptorType ( Report ) */
-		  0x2E,0x00,    /* wDescriptorLength ( Report Size ) */
+		  USBD_CUSTOM_HID_REPORT_DESC_SIZE,0x00,    /* wDescriptorLength ( Report Size ) */
 
 		  /* ENDPOINT DESCRIPTOR */
 		  0x07,	        /* bLength */
@@ -214,6 +222,14 @@ __ALIGN_BEGIN static uint8_t USBD_CUSTOM_HID_CfgHSDesc[USB_CUSTOM_HID_CONFIG_DES
 		  0x03,	        /* bmAttributes	( Interrupt ) */
 		  0x40, 0x00,	/* wMaxPacketSize   (64 Bytes) */
 		  0x02,	        /* bInterval ( 2 ms )*/
+
+		  /* ENDPOINT DESCRIPTOR */
+		  0x07,	        /* bLength */
+		  0x05,	        /* bDescriptorType ( Endpoint )*/
+		  CUSTOM_HID_EPOUT_ADDR,	/* bEndpointAddress (OUT Endpoint 1) */
+		  0x03,	        /* bmAttributes	( Interrupt ) */
+		  CUSTOM_HID_EPOUT_SIZE, 0x00,	/* wMaxPacketSize   (64 Bytes) */
+		  0x01,	        /* bInterval ( 1 ms )*/
 };
 
 /* USB CUSTOM_HID device Other Speed Configuration Descriptor */
@@ -222,7 +238,7 @@ __ALIGN_BEGIN static uint8_t USBD_CUSTOM_HID_OtherSpeedCfgDesc[USB_CUSTOM_HID_CO
 		  /* CONFIG DESCRIPTOR */
 		  0x09,	        /* bLength */
 		  0x02,	        /* bDescriptorType (Configuration)*/
-		  0x22, 0x00,	/* wTotalLength ( size of all structure ) */
+		  USB_CUSTOM_HID_CONFIG_DESC_SIZ, 0x00,	/* wTotalLength ( size of all structure ) */
 		  0x01,	        /* bNumInterfaces */
 		  0x01,	        /* bConfigurationValue */
 		  0x00,	        /* iConfiguration */
@@ -234,7 +250,7 @@ __ALIGN_BEGIN static uint8_t USBD_CUSTOM_HID_OtherSpeedCfgDesc[USB_CUSTOM_HID_CO
 		  0x04,	        /* bDescriptorType (Interface)*/
 		  0x00,	        /* bInterfaceNumber */
 		  0x00,	        /* bAlternateSetting */
-		  0x01,	        /* bNumEndPoints */
+		  0x02,	        /* bNumEndPoints */
 		  0x03,	        /* bInterfaceClass (HID) */
 		  0x00,	        /* bInterfaceSubClass */
 		  0x00,	        /* bInterfaceProtocol */
@@ -247,7 +263,7 @@ __ALIGN_BEGIN static uint8_t USBD_CUSTOM_HID_OtherSpeedCfgDesc[USB_CUSTOM_HID_CO
 		  0x00,         /* bCountryCode */
 		  0x01,         /* bNumDescriptors */
 		  0x22,         /* bDescriptorType ( Report ) */
-		  0x2E,0x00,    /* wDescriptorLength ( Report Size ) */
+		  USBD_CUSTOM_HID_REPORT_DESC_SIZE,0x00,    /* wDescriptorLength ( Report Size ) */
 
 		  /* ENDPOINT DESCRIPTOR */
 		  0x07,	        /* bLength */
@@ -256,6 +272,14 @@ __ALIGN_BEGIN static uint8_t USBD_CUSTOM_HID_OtherSpeedCfgDesc[USB_CUSTOM_HID_CO
 		  0x03,	        /* bmAttributes	( Interrupt ) */
 		  0x40, 0x00,	/* wMaxPacketSize   (64 Bytes) */
 		  0x02,	        /* bInterval ( 2 ms )*/
+
+		  /* ENDPOINT DESCRIPTOR */
+		  0x07,	        /* bLength */
+		  0x05,	        /* bDescriptorType ( Endpoint )*/
+		  CUSTOM_HID_EPOUT_ADDR,	/* bEndpointAddress (OUT Endpoint 1) */
+		  0x03,	        /* bmAttributes	( Interrupt ) */
+		  CUSTOM_HID_EPOUT_SIZE, 0x00,	/* wMaxPacketSize   (64 Bytes) */
+		  0x01,	        /* bInterval ( 1 ms )*/
 };
 
 /* USB CUSTOM_HID device Configuration Descriptor */
@@ -332,11 +356,13 @@ static uint8_t  USBD_CUSTOM_HID_Init(USBD_HandleTypeDef *pdev,
     hhid = (USBD_CUSTOM_HID_HandleTypeDef *) pdev->pClassData;
 
     hhid->state = CUSTOM_HID_IDLE;
+    hhid->Out_idx = 0U;
+    hhid->In_pending = 0U;
     ((USBD_CUSTOM_HID_ItfTypeDef *)pdev->pUserData)->Init();
 
     /* Prepare Out endpoint to receive 1st packet */
-    USBD_LL_PrepareReceive(pdev, CUSTOM_HID_EPOUT_ADDR, hhid->Report_buf,
-                           USBD_CUSTOMHID_OUTREPORT_BUF_SIZE);
+    USBD_LL_PrepareReceive(pdev, CUSTOM_HID_EPOUT_ADDR, hhid->Out_buf[0],
+                           CUSTOM_HID_EPOUT_SIZE);
   }
 
   return ret;
@@ -412,6 +438,22 @@ static uint8_t  USBD_CUSTOM_HID_Setup(USBD_HandleTypeDef *pdev,
           USBD_CtlPrepareRx(pdev, hhid->Report_buf, req->wLength);
           break;
 
+        case CUSTOM_HID_REQ_GET_REPORT:
+          if (((USBD_CUSTOM_HID_ItfTypeDef *)pdev->pUserData)->GetReport != NULL)
+          {
+            pbuf = ((USBD_CUSTOM_HID_ItfTypeDef *)pdev->pUserData)->GetReport((uint8_t)(req->wValue), &len);
+          }
+          if (pbuf != NULL)
+          {
+            USBD_CtlSendData(pdev, pbuf, MIN(len, req->wLength));
+          }
+          else
+          {
+            USBD_CtlError(pdev, req);
+            ret = USBD_FAIL;
+          }
+          break;
+
         default:
           USBD_CtlError(pdev, req);
           ret = USBD_FAIL;
@@ -493,30 +535,52 @@ static uint8_t  USBD_CUSTOM_HID_Setup(USBD_HandleTypeDef *pdev,
 
 /**
   * @brief  USBD_CUSTOM_HID_SendReport
-  *         Send CUSTOM_HID Report
+  *         Send CUSTOM_HID Report. While the endpoint is busy one further
+  *         report is copied into In_buf and sent from DataIn, so the host
+  *         finds data on the very next IN token.
   * @param  pdev: device instance
   * @param  buff: pointer to report
-  * @retval status
+  * @retval status (USBD_BUSY if a report is already staged)
   */
 uint8_t USBD_CUSTOM_HID_SendReport(USBD_HandleTypeDef  *pdev,
                                    uint8_t *report,
                                    uint16_t len)
 {
   USBD_CUSTOM_HID_HandleTypeDef     *hhid = (USBD_CUSTOM_HID_HandleTypeDef *)pdev->pClassData;
+  uint8_t ret = USBD_OK;
+  uint32_t primask;
 
   if (pdev->dev_state == USBD_STATE_CONFIGURED)
   {
+    if (len > CUSTOM_HID_EPIN_SIZE)
+    {
+      len = CUSTOM_HID_EPIN_SIZE;
+    }
+
+    /* DataIn runs in the USB interrupt and looks at state/In_pending */
+    primask = __get_PRIMASK();
+    __disable_irq();
+
     if (hhid->state == CUSTOM_HID_IDLE)
     {
       hhid->state = CUSTOM_HID_BUSY;
+      /* the HAL copies into the PMA right here, report is free on return */
       USBD_LL_Transmit(pdev, CUSTOM_HID_EPIN_ADDR, report, len);
     }
+    else if (hhid->In_pending == 0U)
+    {
+      (void)memcpy(hhid->In_buf, report, len);
+      hhid->In_len = len;
+      hhid->In_pending = 1U;
+    }
     else
     {
-      return USBD_BUSY;
+      ret = USBD_BUSY;
     }
+
+    __set_PRIMASK(primask);
   }
-  return USBD_OK;
+  return ret;
 }
 
 /**
@@ -568,9 +632,19 @@ static uint8_t  *USBD_CUSTOM_HID_GetOtherSpeedCfgDesc(uint16_t *length)
 static uint8_t  USBD_CUSTOM_HID_DataIn(USBD_HandleTypeDef *pdev,
                                        uint8_t epnum)
 {
+  USBD_CUSTOM_HID_HandleTypeDef     *hhid = (USBD_CUSTOM_HID_HandleTypeDef *)pdev->pClassData;
+
+  /* staged report: hand it to the endpoint without going through IDLE */
+  if (hhid->In_pending != 0U)
+  {
+    hhid->In_pending = 0U;
+    USBD_LL_Transmit(pdev, CUSTOM_HID_EPIN_ADDR, hhid->In_buf, hhid->In_len);
+    return USBD_OK;
+  }
+
   /* Ensure that the FIFO is empty before a new transfer, this condition could
   be caused by  a new transfer before the end of the previous transfer */
-  ((USBD_CUSTOM_HID_HandleTypeDef *)pdev->pClassData)->state = CUSTOM_HID_IDLE;
+  hhid->state = CUSTOM_HID_IDLE;
 
   return USBD_OK;
 }
@@ -587,12 +661,26 @@ static uint8_t  USBD_CUSTOM_HID_DataOut(USBD_HandleTypeDef *pdev,
 {
 
   USBD_CUSTOM_HID_HandleTypeDef     *hhid = (USBD_CUSTOM_HID_HandleTypeDef *)pdev->pClassData;
-
-  ((USBD_CUSTOM_HID_ItfTypeDef *)pdev->pUserData)->OutEvent(hhid->Report_buf[0],
-                                                            hhid->Report_buf[1]);
-
-  USBD_LL_PrepareReceive(pdev, CUSTOM_HID_EPOUT_ADDR, hhid->Report_buf,
-                         USBD_CUSTOMHID_OUTREPORT_BUF_SIZE);
+  USBD_CUSTOM_HID_ItfTypeDef        *itf  = (USBD_CUSTOM_HID_ItfTypeDef *)pdev->pUserData;
+  uint8_t  *buf = hhid->Out_buf[hhid->Out_idx];
+  uint16_t  len = (uint16_t)USBD_LL_GetRxDataSize(pdev, epnum);
+
+  /* Re-arm into the other buffer before handling this one: the endpoint is
+     VALID again right away and the host's next report is ACKed instead of
+     NAKed while the callback runs. The FS core only double-buffers bulk and
+     isochronous endpoints in the PMA, so this is done in RAM. */
+  hhid->Out_idx ^= 1U;
+  USBD_LL_PrepareReceive(pdev, CUSTOM_HID_EPOUT_ADDR, hhid->Out_buf[hhid->Out_idx],
+                         CUSTOM_HID_EPOUT_SIZE);
+
+  if (itf->OutReport != NULL)
+  {
+    itf->OutReport(buf, len);
+  }
+  else
+  {
+    itf->OutEvent(buf[0], buf[1]);
+  }
 
   return USBD_OK;
 }
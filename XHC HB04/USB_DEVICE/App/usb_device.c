@@ -27,6 +27,8 @@
 #include "usbd_custom_hid_if.h"
 
 /* USER CODE BEGIN Includes */
+#include "xhc_config.h"
+#include "usbd_composite.h"
 
 /* USER CODE END Includes */
 
@@ -72,7 +74,11 @@ void MX_USB_DEVICE_Init(void)
   {
     Error_Handler();
   }
+#if XHC_USB_CDC
+  if (USBD_RegisterClass(&hUsbDeviceFS, &USBD_COMPOSITE) != USBD_OK)
+#else
   if (USBD_RegisterClass(&hUsbDeviceFS, &USBD_CUSTOM_HID) != USBD_OK)
+#endif
   {
     Error_Handler();
   }
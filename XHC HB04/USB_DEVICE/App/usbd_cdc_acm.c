@@ -0,0 +1,225 @@
+/*
+ * usbd_cdc_acm.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Minimale CDC-ACM-Funktion (siehe usbd_cdc_acm.h)
+ */
+
+#include <string.h>
+#include "usbd_cdc_acm.h"
+#include "usbd_ctlreq.h"
+#include "xhc_config.h"
+
+#if XHC_USB_CDC   /* ohne CDC kein RAM für Ringe und Deskriptor */
+
+#define CDC_SET_LINE_CODING         0x20U
+#define CDC_GET_LINE_CODING         0x21U
+#define CDC_SET_CONTROL_LINE_STATE  0x22U
+#define CDC_SEND_BREAK              0x23U
+#define CDC_NO_CMD                  0xFFU
+
+static USBD_HandleTypeDef *s_pdev;
+
+/* 115200 8N1 – nur Buchhaltung, am virtuellen Port ohne Bedeutung */
+static uint8_t  s_line_coding[7] = { 0x00, 0xC2, 0x01, 0x00, 0x00, 0x00, 0x08 };
+static uint8_t  s_cmd = CDC_NO_CMD;
+static uint8_t  s_alt = 0;
+static volatile uint8_t s_open = 0;          /* DTR */
+
+static uint8_t  s_rx_pkt[CDC_DATA_SIZE];
+static uint8_t  s_rx_ring[CDC_RX_RING_SIZE];
+static volatile uint16_t s_rx_head, s_rx_tail;
+static volatile uint32_t s_rx_dropped;
+
+static uint8_t  s_tx_pkt[CDC_DATA_SIZE];
+static uint8_t  s_tx_ring[CDC_TX_RING_SIZE];
+static volatile uint16_t s_tx_head, s_tx_tail;
+static volatile uint8_t  s_tx_busy;
+static volatile uint32_t s_tx_dropped;
+
+/* nächstes Paket losschicken; aus dem USB-IRQ oder mit gesperrten IRQs.
+   Höchstens 63 Byte je Paket: ein kurzes Paket beendet den Transfer,
+   es braucht nie ein Null-Paket. */
+static void Cdc_Kick(void)
+{
+    if (s_tx_busy || s_pdev == NULL || s_tx_head == s_tx_tail) return;
+
+    uint16_t n = 0, t = s_tx_tail;
+    while (n < CDC_DATA_SIZE - 1U && t != s_tx_head){
+        s_tx_pkt[n++] = s_tx_ring[t];
+        t = (uint16_t)((t + 1U) % CDC_TX_RING_SIZE);
+    }
+    s_tx_tail = t;
+    s_tx_busy = 1U;
+    USBD_LL_Transmit(s_pdev, CDC_IN_EP, s_tx_pkt, n);
+}
+
+/* ===================== Klasse (USB-Interrupt) ===================== */
+
+uint8_t USBD_CDC_ACM_Init(USBD_HandleTypeDef *pdev)
+{
+    USBD_LL_OpenEP(pdev, CDC_IN_EP, USBD_EP_TYPE_BULK, CDC_DATA_SIZE);
+    pdev->ep_in[CDC_IN_EP & 0xFU].is_used = 1U;
+    USBD_LL_OpenEP(pdev, CDC_OUT_EP, USBD_EP_TYPE_BULK, CDC_DATA_SIZE);
+    pdev->ep_out[CDC_OUT_EP & 0xFU].is_used = 1U;
+    USBD_LL_OpenEP(pdev, CDC_CMD_EP, USBD_EP_TYPE_INTR, CDC_CMD_SIZE);
+    pdev->ep_in[CDC_CMD_EP & 0xFU].is_used = 1U;
+
+    s_pdev = pdev;
+    s_cmd = CDC_NO_CMD;
+    s_open = 0U;
+    s_tx_busy = 0U;
+    s_tx_head = s_tx_tail = 0U;
+    s_rx_head = s_rx_tail = 0U;
+
+    USBD_LL_PrepareReceive(pdev, CDC_OUT_EP, s_rx_pkt, CDC_DATA_SIZE);
+    return USBD_OK;
+}
+
+void USBD_CDC_ACM_DeInit(USBD_HandleTypeDef *pdev)
+{
+    USBD_LL_CloseEP(pdev, CDC_IN_EP);
+    pdev->ep_in[CDC_IN_EP & 0xFU].is_used = 0U;
+    USBD_LL_CloseEP(pdev, CDC_OUT_EP);
+    pdev->ep_out[CDC_OUT_EP & 0xFU].is_used = 0U;
+    USBD_LL_CloseEP(pdev, CDC_CMD_EP);
+    pdev->ep_in[CDC_CMD_EP & 0xFU].is_used = 0U;
+
+    s_pdev = NULL;
+    s_open = 0U;
+    s_tx_busy = 0U;
+}
+
+uint8_t USBD_CDC_ACM_Setup(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req)
+{
+    static uint16_t status = 0U;
+
+    switch (req->bmRequest & USB_REQ_TYPE_MASK)
+    {
+    case USB_REQ_TYPE_CLASS:
+        switch (req->bRequest)
+        {
+        case CDC_SET_LINE_CODING:
+            s_cmd = CDC_SET_LINE_CODING;
+            USBD_CtlPrepareRx(pdev, s_line_coding, MIN(req->wLength, sizeof(s_line_coding)));
+            break;
+        case CDC_GET_LINE_CODING:
+            USBD_CtlSendData(pdev, s_line_coding, MIN(req->wLength, sizeof(s_line_coding)));
+            break;
+        case CDC_SET_CONTROL_LINE_STATE:
+            s_open = (uint8_t)(req->wValue & 0x01U);
+            if (!s_open){
+                /* Terminal zu: Altlast verwerfen, nächste Sitzung beginnt frisch */
+                s_tx_tail = s_tx_head;
+            }
+            break;
+        case CDC_SEND_BREAK:
+            break;
+        default:
+            USBD_CtlError(pdev, req);
+            return USBD_FAIL;
+        }
+        break;
+
+    case USB_REQ_TYPE_STANDARD:
+        switch (req->bRequest)
+        {
+        case USB_REQ_GET_STATUS:
+            USBD_CtlSendData(pdev, (uint8_t *)&status, 2U);
+            break;
+        case USB_REQ_GET_INTERFACE:
+            USBD_CtlSendData(pdev, &s_alt, 1U);
+            break;
+        case USB_REQ_SET_INTERFACE:
+            if ((uint8_t)req->wValue != 0U){
+                USBD_CtlError(pdev, req);
+                return USBD_FAIL;
+            }
+            break;
+        default:
+            USBD_CtlError(pdev, req);
+            return USBD_FAIL;
+        }
+        break;
+
+    default:
+        USBD_CtlError(pdev, req);
+        return USBD_FAIL;
+    }
+    return USBD_OK;
+}
+
+void USBD_CDC_ACM_EP0_RxReady(USBD_HandleTypeDef *pdev)
+{
+    (void)pdev;
+    /* SET_LINE_CODING ist schon in s_line_coding gelandet */
+    s_cmd = CDC_NO_CMD;
+}
+
+void USBD_CDC_ACM_DataIn(USBD_HandleTypeDef *pdev)
+{
+    (void)pdev;
+    s_tx_busy = 0U;
+    Cdc_Kick();
+}
+
+void USBD_CDC_ACM_DataOut(USBD_HandleTypeDef *pdev)
+{
+    uint16_t n = (uint16_t)USBD_LL_GetRxDataSize(pdev, CDC_OUT_EP);
+
+    for (uint16_t i = 0; i < n; ++i){
+        uint16_t next = (uint16_t)((s_rx_head + 1U) % CDC_RX_RING_SIZE);
+        if (next == s_rx_tail){ s_rx_dropped += (uint32_t)(n - i); break; }
+        s_rx_ring[s_rx_head] = s_rx_pkt[i];
+        s_rx_head = next;
+    }
+    USBD_LL_PrepareReceive(pdev, CDC_OUT_EP, s_rx_pkt, CDC_DATA_SIZE);
+}
+
+/* ===================== Anwendung ===================== */
+
+uint16_t XHC_CDC_TxFree(void)
+{
+    uint16_t used = (uint16_t)((s_tx_head + CDC_TX_RING_SIZE - s_tx_tail) % CDC_TX_RING_SIZE);
+    return (uint16_t)(CDC_TX_RING_SIZE - 1U - used);
+}
+
+uint16_t XHC_CDC_Write(const void *data, uint16_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    if (!s_open || s_pdev == NULL) return 0;
+
+    uint16_t n = XHC_CDC_TxFree();
+    if (n > len) n = len;
+    s_tx_dropped += (uint32_t)(len - n);
+
+    /* nur der Kopf gehört der Anwendung, der IRQ bewegt nur den Schwanz */
+    uint16_t h = s_tx_head;
+    for (uint16_t i = 0; i < n; ++i){
+        s_tx_ring[h] = p[i];
+        h = (uint16_t)((h + 1U) % CDC_TX_RING_SIZE);
+    }
+    s_tx_head = h;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Cdc_Kick();
+    __set_PRIMASK(primask);
+    return n;
+}
+
+uint16_t XHC_CDC_Read(uint8_t *dst, uint16_t max)
+{
+    uint16_t n = 0;
+    while (n < max && s_rx_tail != s_rx_head){
+        dst[n++] = s_rx_ring[s_rx_tail];
+        s_rx_tail = (uint16_t)((s_rx_tail + 1U) % CDC_RX_RING_SIZE);
+    }
+    return n;
+}
+
+uint8_t  XHC_CDC_Connected(void){ return s_open; }
+uint32_t XHC_CDC_TxDropped(void){ return s_tx_dropped; }
+uint32_t XHC_CDC_RxDropped(void){ return s_rx_dropped; }
+
+#endif /* XHC_USB_CDC */
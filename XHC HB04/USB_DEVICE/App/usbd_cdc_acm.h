@@ -0,0 +1,58 @@
+/*
+ * usbd_cdc_acm.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Minimale CDC-ACM-Funktion (virtuelle serielle Schnittstelle) für das
+ *      Composite-Gerät: Interface 1 (Steuerung) + 2 (Daten), Bulk 0x83/0x03.
+ *      Kein eigenes pClassData – läuft neben der HID-Klasse, die
+ *      USBD_COMPOSITE (usbd_composite.c) ruft die Funktionen hier auf.
+ */
+
+#ifndef __USBD_CDC_ACM_H
+#define __USBD_CDC_ACM_H
+
+#pragma once
+#include <stdint.h>
+#include "usbd_ioreq.h"
+#include "xhc_config.h"
+
+#define CDC_COMM_ITF        0x01U
+#define CDC_DATA_ITF        0x02U
+#define CDC_CMD_EP          0x82U
+#define CDC_IN_EP           0x83U
+#define CDC_OUT_EP          0x03U
+#define CDC_CMD_SIZE        0x08U
+#define CDC_DATA_SIZE       0x40U
+
+/* Puffer im RAM: Sendering für Telemetrie/Konsole, Empfang für Befehlszeilen */
+#define CDC_TX_RING_SIZE    XHC_CDC_TX_RING
+#define CDC_RX_RING_SIZE    XHC_CDC_RX_RING
+
+/* ---- von USBD_COMPOSITE (USB-Interrupt) ---- */
+uint8_t USBD_CDC_ACM_Init(USBD_HandleTypeDef *pdev);
+void    USBD_CDC_ACM_DeInit(USBD_HandleTypeDef *pdev);
+uint8_t USBD_CDC_ACM_Setup(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req);
+void    USBD_CDC_ACM_EP0_RxReady(USBD_HandleTypeDef *pdev);
+void    USBD_CDC_ACM_DataIn(USBD_HandleTypeDef *pdev);
+void    USBD_CDC_ACM_DataOut(USBD_HandleTypeDef *pdev);
+
+/* ---- Anwendung (Hauptschleife) ---- */
+
+/* nicht blockierend: übernimmt, was in den Sendering passt, Rest verworfen;
+   Rückgabe = übernommene Bytes. Ohne geöffneten Port (DTR) 0. */
+uint16_t XHC_CDC_Write(const void *data, uint16_t len);
+
+/* freier Platz im Sendering */
+uint16_t XHC_CDC_TxFree(void);
+
+/* empfangene Bytes abholen, Rückgabe = Anzahl */
+uint16_t XHC_CDC_Read(uint8_t *dst, uint16_t max);
+
+/* 1 = Terminal hat den Port geöffnet (DTR gesetzt) */
+uint8_t  XHC_CDC_Connected(void);
+
+/* Statistik: wegen vollem Ring verworfene Bytes (TX, RX) */
+uint32_t XHC_CDC_TxDropped(void);
+uint32_t XHC_CDC_RxDropped(void);
+
+#endif /* __USBD_CDC_ACM_H */
@@ -0,0 +1,147 @@
+/*
+ * usbd_composite.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Composite-Klasse HID + CDC-ACM (siehe usbd_composite.h)
+ */
+
+#include "usbd_composite.h"
+#include "usbd_customhid.h"
+#include "usbd_cdc_acm.h"
+#include "usbd_ctlreq.h"
+#include "xhc_config.h"
+
+#if XHC_USB_CDC   /* ohne CDC kein RAM für Ringe und Deskriptor */
+
+/* Konfiguration: HID wie in usbd_customhid.c, dann IAD + CDC-ACM */
+__ALIGN_BEGIN static uint8_t s_cfg_desc[USB_COMPOSITE_CONFIG_DESC_SIZ] __ALIGN_END =
+{
+    /* CONFIG DESCRIPTOR */
+    0x09, 0x02, USB_COMPOSITE_CONFIG_DESC_SIZ, 0x00,
+    0x03,           /* bNumInterfaces: HID, CDC-Steuerung, CDC-Daten */
+    0x01,           /* bConfigurationValue */
+    0x00,           /* iConfiguration */
+    0x80,           /* bmAttributes */
+    0x32,           /* bMaxPower (100 mA) */
+
+    /* ---- Interface 0: HID (unverändert) ---- */
+    0x09, 0x04, 0x00, 0x00, 0x02, 0x03, 0x00, 0x00, 0x00,
+    0x09, 0x21, 0x10, 0x01, 0x00, 0x01, 0x22, USBD_CUSTOM_HID_REPORT_DESC_SIZE, 0x00,
+    0x07, 0x05, CUSTOM_HID_EPIN_ADDR,  0x03, CUSTOM_HID_EPIN_SIZE,  0x00, 0x02,
+    0x07, 0x05, CUSTOM_HID_EPOUT_ADDR, 0x03, CUSTOM_HID_EPOUT_SIZE, 0x00, 0x01,
+
+    /* ---- IAD: Interface 1+2 gehören zusammen (CDC) ---- */
+    0x08, 0x0B, CDC_COMM_ITF, 0x02, 0x02, 0x02, 0x01, 0x00,
+
+    /* ---- Interface 1: CDC-Steuerung ---- */
+    0x09, 0x04, CDC_COMM_ITF, 0x00, 0x01, 0x02, 0x02, 0x01, 0x00,
+    0x05, 0x24, 0x00, 0x10, 0x01,                   /* Header, CDC 1.10 */
+    0x05, 0x24, 0x01, 0x00, CDC_DATA_ITF,           /* Call Management */
+    0x04, 0x24, 0x02, 0x02,                         /* ACM: Line Coding/State */
+    0x05, 0x24, 0x06, CDC_COMM_ITF, CDC_DATA_ITF,   /* Union */
+    0x07, 0x05, CDC_CMD_EP, 0x03, CDC_CMD_SIZE, 0x00, 0x10,
+
+    /* ---- Interface 2: CDC-Daten ---- */
+    0x09, 0x04, CDC_DATA_ITF, 0x00, 0x02, 0x0A, 0x00, 0x00, 0x00,
+    0x07, 0x05, CDC_OUT_EP, 0x02, CDC_DATA_SIZE, 0x00, 0x00,
+    0x07, 0x05, CDC_IN_EP,  0x02, CDC_DATA_SIZE, 0x00, 0x00,
+};
+
+static uint8_t Composite_IsCdcItf(uint8_t itf)
+{
+    return (itf == CDC_COMM_ITF || itf == CDC_DATA_ITF) ? 1U : 0U;
+}
+
+static uint8_t Composite_IsCdcEp(uint8_t ep)
+{
+    ep &= 0x7FU;
+    return (ep == (CDC_IN_EP & 0x7FU) || ep == (CDC_OUT_EP & 0x7FU) ||
+            ep == (CDC_CMD_EP & 0x7FU)) ? 1U : 0U;
+}
+
+static uint8_t Composite_Init(USBD_HandleTypeDef *pdev, uint8_t cfgidx)
+{
+    uint8_t ret = USBD_CUSTOM_HID.Init(pdev, cfgidx);
+    if (ret != USBD_OK) return ret;
+    return USBD_CDC_ACM_Init(pdev);
+}
+
+static uint8_t Composite_DeInit(USBD_HandleTypeDef *pdev, uint8_t cfgidx)
+{
+    USBD_CDC_ACM_DeInit(pdev);
+    return USBD_CUSTOM_HID.DeInit(pdev, cfgidx);
+}
+
+static uint8_t Composite_Setup(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req)
+{
+    switch (req->bmRequest & USB_REQ_RECIPIENT_MASK)
+    {
+    case USB_REQ_RECIPIENT_INTERFACE:
+        if (Composite_IsCdcItf(LOBYTE(req->wIndex))) return USBD_CDC_ACM_Setup(pdev, req);
+        break;
+    case USB_REQ_RECIPIENT_ENDPOINT:
+        if (Composite_IsCdcEp(LOBYTE(req->wIndex))) return USBD_CDC_ACM_Setup(pdev, req);
+        break;
+    default:
+        break;
+    }
+    return USBD_CUSTOM_HID.Setup(pdev, req);
+}
+
+static uint8_t Composite_EP0_RxReady(USBD_HandleTypeDef *pdev)
+{
+    /* beide prüfen selbst, ob die Datenstufe ihnen gehört */
+    USBD_CDC_ACM_EP0_RxReady(pdev);
+    return USBD_CUSTOM_HID.EP0_RxReady(pdev);
+}
+
+static uint8_t Composite_DataIn(USBD_HandleTypeDef *pdev, uint8_t epnum)
+{
+    if (epnum == (CDC_IN_EP & 0x7FU)){
+        USBD_CDC_ACM_DataIn(pdev);
+        return USBD_OK;
+    }
+    if (epnum == (CDC_CMD_EP & 0x7FU)) return USBD_OK;
+    return USBD_CUSTOM_HID.DataIn(pdev, epnum);
+}
+
+static uint8_t Composite_DataOut(USBD_HandleTypeDef *pdev, uint8_t epnum)
+{
+    if (epnum == (CDC_OUT_EP & 0x7FU)){
+        USBD_CDC_ACM_DataOut(pdev);
+        return USBD_OK;
+    }
+    return USBD_CUSTOM_HID.DataOut(pdev, epnum);
+}
+
+/* nur Full Speed: alle drei Varianten liefern dieselbe Konfiguration */
+static uint8_t *Composite_GetCfgDesc(uint16_t *length)
+{
+    *length = sizeof(s_cfg_desc);
+    return s_cfg_desc;
+}
+
+static uint8_t *Composite_GetDeviceQualifierDesc(uint16_t *length)
+{
+    return USBD_CUSTOM_HID.GetDeviceQualifierDescriptor(length);
+}
+
+USBD_ClassTypeDef USBD_COMPOSITE =
+{
+    Composite_Init,
+    Composite_DeInit,
+    Composite_Setup,
+    NULL,                   /* EP0_TxSent */
+    Composite_EP0_RxReady,
+    Composite_DataIn,
+    Composite_DataOut,
+    NULL,                   /* SOF (läuft über XHC_Sof_Irq in usbd_conf.c) */
+    NULL,
+    NULL,
+    Composite_GetCfgDesc,
+    Composite_GetCfgDesc,
+    Composite_GetCfgDesc,
+    Composite_GetDeviceQualifierDesc,
+};
+
+#endif /* XHC_USB_CDC */
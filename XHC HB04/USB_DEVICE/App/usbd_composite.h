@@ -0,0 +1,22 @@
+/*
+ * usbd_composite.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Composite-Gerät HID + CDC-ACM (XHC_USB_CDC=1).
+ *      Interface 0 bleibt das HID-Interface, das LinuxCNC erwartet
+ *      (EP 0x81/0x01, unverändert), dahinter per IAD die serielle
+ *      Konsole/Telemetrie auf Interface 1+2. Die Klasse verteilt Setup-
+ *      Requests nach Interface/Endpoint und Datenstufen nach Endpoint.
+ */
+
+#ifndef __USBD_COMPOSITE_H
+#define __USBD_COMPOSITE_H
+
+#pragma once
+#include "usbd_ioreq.h"
+
+#define USB_COMPOSITE_CONFIG_DESC_SIZ   107U
+
+extern USBD_ClassTypeDef USBD_COMPOSITE;
+
+#endif /* __USBD_COMPOSITE_H */
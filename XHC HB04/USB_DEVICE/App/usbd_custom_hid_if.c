@@ -26,6 +26,7 @@
 #include "usb_device.h"
 #include "usbd_customhid.h"  // deklariert USBD_CUSTOM_HID_ReceivePacket()
 #include "usbd_core.h"
+#include "xhc_telemetry.h"
 
 #ifndef __USB_DEVICE__H
 extern USBD_HandleTypeDef hUsbDeviceFS;
@@ -58,6 +59,9 @@ static volatile uint16_t   rx_tail = 0;     // liest die Anwendung
 static volatile uint32_t   rx_dropped = 0;  // Statistik: überlaufene Pakete
 static xhc_rx_item_t       rx_ring[XHC_RX_RING_SIZE];
 
+static volatile uint8_t    s_mode = XHC_MODE_LEGACY;   // Feature 0x0C
+static uint8_t             s_mode_rep[8];              // GET_REPORT-Antwort
+
 /* Hilfs-Makros */
 #define RING_NEXT(i)  (uint16_t)(((i) + 1u) % XHC_RX_RING_SIZE)
 #define RING_EMPTY()  (rx_head == rx_tail)
@@ -101,8 +105,18 @@ uint8_t XHC_RX_TryPop(uint8_t *dst, uint16_t *io_len)
     return 0;
 }
 
+/* IN-Report senden, 0 = Endpoint und Vorratsplatz belegt / nicht konfiguriert (später nochmal) */
+uint8_t XHC_TX_Send(uint8_t *report, uint16_t len)
+{
+    if (hUsbDeviceFS.dev_state != USBD_STATE_CONFIGURED) return 0;
+    if (USBD_CUSTOM_HID_SendReport(&hUsbDeviceFS, report, len) != USBD_OK) return 0;
+    XHC_Tel_Log(TEL_TX, report[0], len);
+    return 1;
+}
+
 uint32_t XHC_RX_Count(void){ return (rx_head>=rx_tail)? (rx_head-rx_tail):(XHC_RX_RING_SIZE-(rx_tail-rx_head)); }
 uint32_t XHC_RX_Dropped(void){ return rx_dropped; }
+uint8_t  XHC_Mode(void){ return s_mode; }
 
 /* Helper: OUT-EP nach Empfang wieder scharf schalten */
 static inline void XHC_Push_(const uint8_t *buf, uint16_t len)
@@ -114,8 +128,10 @@ static inline void XHC_Push_(const uint8_t *buf, uint16_t len)
         rx_ring[idx].len = len;
         memcpy(rx_ring[idx].data, buf, len);
         rx_head = RING_NEXT(rx_head);
+        XHC_Tel_Log(TEL_RX, buf[0], len);
     } else {
         rx_dropped++;
+        XHC_Tel_Log(TEL_RX_DROP, buf[0], TEL_DROP_RING);
     }
 }
 /* USER CODE END PRIVATE_TYPES */
@@ -181,6 +197,34 @@ __ALIGN_BEGIN static uint8_t CUSTOM_HID_ReportDesc_FS[USBD_CUSTOM_HID_REPORT_DES
 	    0x95,0x07, 				/* Report Count (7) */
 	    0x75,0x08, 				/* Report Size (8) */
 	    0xB1,0x06, 				/* Feature (Data,Var,Rel,NWrp,Lin,Pref,NNul,NVol,Bit) */
+	    0xC0, 			/* End Collection */
+
+	    0x06,0x00,0xFF, 	        /* Usage Page (Vendor-Defined 1) */
+	    0x09,0x02, 			/* Usage (Vendor-Defined 2) */
+	    0xA1,0x01, 			/* Collection (Application) */
+	    0x85,0x0A, 				/* Report ID (10) - Screenshot anfordern */
+	    0x09,0x02, 				/* Usage (Vendor-Defined 2) */
+	    0x15,0x00, 				/* Logical Minimum (0) */
+	    0x26,0xFF,0x00, 		        /* Logical Maximum (255) */
+	    0x95,0x07, 				/* Report Count (7) */
+	    0x75,0x08, 				/* Report Size (8) */
+	    0xB1,0x02, 				/* Feature (Data,Var,Abs) */
+	    0x85,0x0B, 				/* Report ID (11) - Screenshot-Daten */
+	    0x09,0x02, 				/* Usage (Vendor-Defined 2) */
+	    0x95,0x3F, 				/* Report Count (63) */
+	    0x81,0x02, 				/* Input (Data,Var,Abs) */
+	    0x85,0x0C, 				/* Report ID (12) - Modus aushandeln */
+	    0x09,0x03, 				/* Usage (Vendor-Defined 3) */
+	    0x95,0x07, 				/* Report Count (7) */
+	    0xB1,0x02, 				/* Feature (Data,Var,Abs) */
+	    0x85,0x0D, 				/* Report ID (13) - ganzer Frame, EP 0x01 */
+	    0x09,0x03, 				/* Usage (Vendor-Defined 3) */
+	    0x95,0x3F, 				/* Report Count (63) */
+	    0x91,0x02, 				/* Output (Data,Var,Abs) */
+	    0x85,0x0E, 				/* Report ID (14) - Delta, EP 0x01 */
+	    0x09,0x03, 				/* Usage (Vendor-Defined 3) */
+	    0x95,0x3F, 				/* Report Count (63) */
+	    0x91,0x02, 				/* Output (Data,Var,Abs) */
   /* USER CODE END 0 */
   0xC0    /*     END_COLLECTION	             */
 };
@@ -214,6 +258,8 @@ extern USBD_HandleTypeDef hUsbDeviceFS;
 static int8_t CUSTOM_HID_Init_FS(void);
 static int8_t CUSTOM_HID_DeInit_FS(void);
 static int8_t CUSTOM_HID_OutEvent_FS(uint8_t event_idx, uint8_t state);
+static int8_t CUSTOM_HID_OutReport_FS(uint8_t *report, uint16_t len);
+static uint8_t *CUSTOM_HID_GetReport_FS(uint8_t report_id, uint16_t *len);
 
 /**
   * @}
@@ -224,7 +270,9 @@ USBD_CUSTOM_HID_ItfTypeDef USBD_CustomHID_fops_FS =
   CUSTOM_HID_ReportDesc_FS,
   CUSTOM_HID_Init_FS,
   CUSTOM_HID_DeInit_FS,
-  CUSTOM_HID_OutEvent_FS
+  CUSTOM_HID_OutEvent_FS,
+  CUSTOM_HID_OutReport_FS,
+  CUSTOM_HID_GetReport_FS
 };
 
 /** @defgroup USBD_CUSTOM_HID_Private_Functions USBD_CUSTOM_HID_Private_Functions
@@ -252,6 +300,7 @@ static int8_t CUSTOM_HID_Init_FS(void)
 static int8_t CUSTOM_HID_DeInit_FS(void)
 {
   /* USER CODE BEGIN 5 */
+  s_mode = XHC_MODE_LEGACY;     /* nach Reset/Abstecken neu aushandeln */
   return (USBD_OK);
   /* USER CODE END 5 */
 }
@@ -287,11 +336,56 @@ static int8_t CUSTOM_HID_OutEvent_FS(uint8_t event_idx, uint8_t state)
 	        len = (8u <= XHC_FEAT_MAX_LEN) ? 8u : XHC_FEAT_MAX_LEN;
 	    }
 
+	    /* Modus-Feature wird hier erledigt, nicht in den Ring */
+	    if (hhid->Report_buf[0] == XHC_MODE_FEAT_ID) {
+	        uint8_t m = hhid->Report_buf[1];
+	        if (m == XHC_MODE_LEGACY || m == XHC_MODE_FAST) s_mode = m;
+	        return (USBD_OK);
+	    }
+
 	    XHC_Push_(hhid->Report_buf, len);
   return (USBD_OK);
   /* USER CODE END 6 */
 }
 
+/**
+  * @brief  Report vom Interrupt-OUT-Endpoint (EP 0x01)
+  * @param  report: Report inkl. Report-ID
+  * @param  len: empfangene Länge
+  * @retval USBD_OK
+  */
+static int8_t CUSTOM_HID_OutReport_FS(uint8_t *report, uint16_t len)
+{
+  /* ganzer Frame oder Delta in einem Report: nur im ausgehandelten Schnellmodus */
+  if (len >= 1u && s_mode == XHC_MODE_FAST &&
+      (report[0] == XHC_FRAME_OUT_ID || report[0] == XHC_DELTA_OUT_ID)) {
+      XHC_Push_(report, len);
+  } else {
+      rx_dropped++;
+      XHC_Tel_Log(TEL_RX_DROP, len ? report[0] : 0u, TEL_DROP_MODE);
+  }
+  return (USBD_OK);
+}
+
+/**
+  * @brief  GET_REPORT (Feature) beantworten
+  * @param  report_id: angefragte Report-ID
+  * @param  len: Länge der Antwort
+  * @retval Antwort oder NULL (Stall)
+  */
+static uint8_t *CUSTOM_HID_GetReport_FS(uint8_t report_id, uint16_t *len)
+{
+  if (report_id != XHC_MODE_FEAT_ID) return NULL;
+
+  memset(s_mode_rep, 0, sizeof(s_mode_rep));
+  s_mode_rep[0] = XHC_MODE_FEAT_ID;
+  s_mode_rep[1] = s_mode;
+  s_mode_rep[2] = XHC_PROTO_VERSION;
+  s_mode_rep[3] = XHC_CAP_FAST_FRAME | XHC_CAP_DELTA;
+  *len = sizeof(s_mode_rep);
+  return s_mode_rep;
+}
+
 /* USER CODE BEGIN 7 */
 /**
   * @brief  Send the report to the Host
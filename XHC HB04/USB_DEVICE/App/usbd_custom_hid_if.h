@@ -52,6 +52,38 @@
  uint8_t  XHC_RX_TryPop(uint8_t *dst, uint16_t *io_len);
  uint32_t XHC_RX_Count(void);
  uint32_t XHC_RX_Dropped(void);
+ uint8_t  XHC_TX_Send(uint8_t *report, uint16_t len);
+
+/* Schnellmodus (ausgehandelt über Feature 0x0C):
+   Feature 0x0C SET  [0x0C][mode]                    mode 0 = Chunks, 1 = schnell
+   Feature 0x0C GET  [0x0C][mode][version][caps][0 0 0 0]
+   Output  0x0D      [0x0D][37 Byte whb04_out_data_t][Rest 0]  über EP 0x01
+   Output  0x0E      [0x0E][mask lo][mask hi][geänderte Felder]  über EP 0x01
+   Feature 0x06 (7-Byte-Chunks) bleibt in beiden Modi gültig.
+
+   Delta 0x0E: Felder in Bit-Reihenfolge, little endian, nur gesetzte Bits.
+   Gilt nur auf einem vorher per 0x0D (oder Chunks) empfangenen Frame; der
+   Host schickt regelmäßig einen ganzen Frame als Schlüsselbild.
+     Bit 0..5   pos[i]        4 Byte (p_int, p_frac)  Xw Yw Zw Xm Ym Zm
+     Bit 6      feedrate_ovr  2 Byte
+     Bit 7      sspeed_ovr    2 Byte
+     Bit 8      feedrate      2 Byte
+     Bit 9      sspeed        2 Byte
+     Bit 10     step_mul      1 Byte
+     Bit 11     state         1 Byte
+     Bit 12     day           1 Byte
+   Referenz-Encoder: tools/xhc_delta.py */
+#define XHC_MODE_FEAT_ID   0x0Cu
+#define XHC_FRAME_OUT_ID   0x0Du
+#define XHC_DELTA_OUT_ID   0x0Eu
+#define XHC_MODE_LEGACY    0u
+#define XHC_MODE_FAST      1u
+#define XHC_PROTO_VERSION  2u
+#define XHC_CAP_FAST_FRAME 0x01u
+#define XHC_CAP_DELTA      0x02u
+#define XHC_DELTA_FIELDS   13u
+
+ uint8_t  XHC_Mode(void);
 /* USER CODE END EXPORTED_DEFINES */
 
 /**
@@ -24,6 +24,8 @@
 #include "usbd_conf.h"
 
 /* USER CODE BEGIN INCLUDE */
+#include "xhc_config.h"
+#include "xhc_proto.h"
 
 /* USER CODE END INCLUDE */
 
@@ -71,6 +73,9 @@
 #define USBD_INTERFACE_STRING_FS     "Custom HID Interface"
 
 /* USER CODE BEGIN PRIVATE_DEFINES */
+/* PID folgt der Pendant-Variante (XHC_PROTO), der Host-Treiber sucht danach */
+#undef  USBD_PID_FS
+#define USBD_PID_FS     XHC_USB_PID
 
 /* USER CODE END PRIVATE_DEFINES */
 
@@ -149,12 +154,18 @@ __ALIGN_BEGIN uint8_t USBD_FS_DeviceDesc[USB_LEN_DEV_DESC] __ALIGN_END =
 	    0x12, 	/* bLength 		*/
 	    0x01, 	/* bDescriptorType      */
 	    0x10,0x01, 	/* bcdUSB 		*/
+#if XHC_USB_CDC
+	    0xEF, 	/* bDeviceClass: Miscellaneous (Composite mit IAD) */
+	    0x02, 	/* bDeviceSubClass: Common Class */
+	    0x01, 	/* bDeviceProtocol: Interface Association */
+#else
 	    0x00, 	/* bDeviceClass 	*/
 	    0x00, 	/* bDeviceSubClass 	*/
 	    0x00, 	/* bDeviceProtocol 	*/
+#endif
 	    0x40, 	/* bMaxPacketSize0 	*/
-	    0xCE,0x10, 	/* idVendor 		*/
-	    0x70,0xEB, 	/* idProduct 		*/
+	    LOBYTE(USBD_VID), HIBYTE(USBD_VID), 	/* idVendor 		*/
+	    LOBYTE(USBD_PID_FS), HIBYTE(USBD_PID_FS), 	/* idProduct: XHC_USB_PID */
 	    0x00,0x00, 	/* bcdDevice 		*/
 	    0x01, 	/* iManufacturer 	*/
 	    0x00, 	/* iProduct 		*/
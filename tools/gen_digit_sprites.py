@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""Sprite-Cache der DRO-Ziffern erzeugen.
+
+Liest Font_13x13 aus tools/fonts/fonts_src.c und schreibt Core/Src/xhc_digits.c:
+die Zeichen der Werte-Zeilen (" #-.0123456789") fertig gerastert als
+RGB565-Zellen, schwarz auf weiß. Die Zellen sind nur so breit wie das
+Zeichenraster der Werte (CHAR_W = 7), weil sich die 13er-Glyphen dort
+überlappen; die Tinte dieser Zeichen liegt ohnehin in Spalte 1..6.
+
+Die Pixel werden als X/_ ausgegeben und erst vom Compiler über
+XHC_DIGIT_PX() in Panel-Byte-Reihenfolge gewandelt.
+
+    ./gen_digit_sprites.py            (aus dem Repo-Wurzelverzeichnis)
+"""
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "XHC HB04")
+FONTS_C = os.path.join(os.path.dirname(os.path.abspath(__file__)), "fonts", "fonts_src.c")
+OUT_C = os.path.join(ROOT, "Core", "Src", "xhc_digits.c")
+
+CHARS = " #-.0123456789"
+FONT_H = 13
+CELL_W = 7
+
+
+def load_font(path, name="Font13x13"):
+    src = open(path, encoding="utf-8", errors="replace").read()
+    start = src.index("%s [] = {" % name)
+    end = src.index("};", start)
+    body = re.sub(r"//.*", "", src[start:end])
+    return [int(v, 16) for v in re.findall(r"0x([0-9A-Fa-f]{4})", body)]
+
+
+def glyph_rows(font, ch):
+    base = (ord(ch) - 32) * FONT_H
+    return font[base:base + FONT_H]
+
+
+def main():
+    font = load_font(FONTS_C)
+    out = []
+    out.append("/*")
+    out.append(" * xhc_digits.c")
+    out.append(" *")
+    out.append(" *  ERZEUGT von tools/gen_digit_sprites.py – nicht von Hand ändern.")
+    out.append(" *      Font_13x13, Zeichen \"%s\", Zellen %dx%d, schwarz auf weiß" % (CHARS, CELL_W, FONT_H))
+    out.append(" */")
+    out.append("")
+    out.append('#include "xhc_digits.h"')
+    out.append("")
+    out.append("#define X XHC_DIGIT_PX(XHC_DIGIT_FG)")
+    out.append("#define _ XHC_DIGIT_PX(XHC_DIGIT_BG)")
+    out.append("")
+    out.append("static const uint16_t s_sprites[XHC_DIGIT_COUNT][XHC_DIGIT_W * XHC_DIGIT_H] = {")
+    for ch in CHARS:
+        rows = glyph_rows(font, ch)
+        ink = 0
+        for r in rows:
+            ink |= r
+        if ink & (0xFFFF >> CELL_W) & 0xFFFF:
+            sys.stderr.write("Hinweis: %r reicht über die Zelle hinaus\n" % ch)
+        out.append("    /* '%s' */ {" % ch)
+        for r in rows:
+            px = ["X" if r & (0x8000 >> c) else "_" for c in range(CELL_W)]
+            out.append("        " + ",".join(px) + ",")
+        out.append("    },")
+    out.append("};")
+    out.append("")
+    out.append("#undef X")
+    out.append("#undef _")
+    out.append("")
+    out.append("const uint16_t* XHC_Digit_Sprite(char c)")
+    out.append("{")
+    out.append("    switch (c){")
+    for i, ch in enumerate(CHARS):
+        out.append("    case '%s': return s_sprites[%d];" % (ch, i))
+    out.append("    default:  return 0;")
+    out.append("    }")
+    out.append("}")
+    out.append("")
+    with open(OUT_C, "w", encoding="utf-8", newline="\n") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""Gepackte Font-Tabellen für die Firmware erzeugen.
+
+Quelle sind die uint16-Zeilentabellen in tools/fonts/fonts_src.c (volles
+ASCII 32..126). Geschrieben wird Core/Src/fonts.c mit
+
+  * einem Bitstrom je Glyphe: width*height Bits, zeilenweise, MSB zuerst,
+    auf ganze Bytes aufgefüllt (konstanter Abstand -> O(1)-Zugriff),
+  * nur den Zeichen aus FONTS unten, als zusammenhängende Bereiche
+    (FontRange). Das erste Zeichen eines Fonts ist der Ersatz für alles,
+    was nicht in der Tabelle steht – deshalb muss ' ' vorne stehen.
+
+Wer neue Texte auf den Schirm bringt, ergänzt hier die Zeichenmenge und
+lässt das Skript neu laufen:
+
+    ./gen_fonts.py
+"""
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SRC = os.path.join(HERE, "fonts", "fonts_src.c")
+OUT_C = os.path.join(HERE, "..", "XHC HB04", "Core", "Src", "fonts.c")
+
+ASCII = "".join(chr(c) for c in range(32, 127))
+UPPER = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+
+# (Quelltabelle, FontDef-Name, Breite, Höhe, Zeichenmenge)
+FONTS = [
+    # Statuszeilen (xhc_display.c) zeigen beliebigen Text, Bars/Footer Zahlen
+    ("Font7x10", "Font_7x10", 7, 10, ASCII),
+    # DRO: Werte, Achsen-/WC-MC-Labels
+    ("Font13x13", "Font_13x13", 13, 13, " #-.0123456789:" + UPPER),
+]
+
+
+def load_table(src, name):
+    start = src.index("%s [] = {" % name)
+    end = src.index("};", start)
+    body = re.sub(r"//.*", "", src[start + len(name):end])
+    body = re.sub(r"/\*.*?\*/", "", body, flags=re.S)
+    return [int(v, 16) for v in re.findall(r"0x([0-9A-Fa-f]{4})", body)]
+
+
+def pack_glyph(rows, width):
+    bits = []
+    for r in rows:
+        bits.extend(1 if r & (0x8000 >> c) else 0 for c in range(width))
+    while len(bits) % 8:
+        bits.append(0)
+    out = []
+    for i in range(0, len(bits), 8):
+        b = 0
+        for bit in bits[i:i + 8]:
+            b = (b << 1) | bit
+        out.append(b)
+    return out
+
+
+def ranges_of(chars):
+    codes = sorted(set(ord(c) for c in chars))
+    # Ersatzglyphe (erstes Zeichen der Menge) bleibt Glyphe 0
+    first = ord(chars[0])
+    codes.remove(first)
+    codes.insert(0, first)
+    ranges, glyph = [], 0
+    for c in codes:
+        if ranges and c == ranges[-1][1] + 1:
+            ranges[-1][1] = c
+        else:
+            ranges.append([c, c, glyph])
+        glyph += 1
+    return codes, ranges
+
+
+def c_char(code):
+    ch = chr(code)
+    return "sp" if ch == " " else ("'\\\\'" if ch == "\\" else ch)
+
+
+def main():
+    src = open(SRC, encoding="utf-8", errors="replace").read()
+    out = [
+        "/* vim: set ai et ts=4 sw=4: */",
+        "/*",
+        " * GENERATED by tools/gen_fonts.py from tools/fonts/fonts_src.c - do not edit.",
+        " * Packed 1bpp glyphs, see fonts.h for the layout.",
+        " */",
+        '#include "fonts.h"',
+        "",
+    ]
+    total = 0
+    for table, name, w, h, chars in FONTS:
+        rows = load_table(src, table)
+        if len(rows) != len(ASCII) * h:
+            sys.exit("%s: %d Zeilen, erwartet %d" % (table, len(rows), len(ASCII) * h))
+        codes, ranges = ranges_of(chars)
+        stride = (w * h + 7) // 8
+        total += stride * len(codes)
+        out.append("// %s: %d glyphs, %d bytes each" % (name, len(codes), stride))
+        out.append("static const uint8_t %s [] = {" % table)
+        for code in codes:
+            base = (code - 32) * h
+            data = pack_glyph(rows[base:base + h], w)
+            out.append(",".join("0x%02X" % b for b in data) + ",  // " + c_char(code))
+        out.append("};")
+        out.append("")
+        out.append("static const FontRange %s_ranges [] = {" % table)
+        for first, last, glyph in ranges:
+            out.append("    { %3d, %3d, %3d }," % (first, last, glyph))
+        out.append("};")
+        out.append("")
+        out.append("FontDef %s = {%d,%d,%d,%d,%s,%s_ranges};"
+                   % (name, w, h, stride, len(ranges), table, table))
+        out.append("")
+        out.append("")
+    with open(OUT_C, "w", encoding="utf-8", newline="\n") as f:
+        f.write("\n".join(out).rstrip("\n") + "\n")
+    print("fonts.c: %d Byte Glyphdaten" % total)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""Statisches DRO-Layout als RLE-Palettenbild erzeugen.
+
+Rastert den Hintergrund, den Render_Static_Layout() in xhc_screen.c
+Primitiv für Primitiv zeichnet (WC/MC- und Achsen-Labels, Trennstrich,
+blaue Fußzeile, F/S-Labels, Bar-Rahmen), mit denselben Koordinaten und
+Fonts (tools/fonts/fonts_src.c) nach und schreibt Core/Src/xhc_layout_img.c.
+Die Firmware entpackt das Bild bandweise in den Strip-Puffer und schickt
+jedes Band per DMA (XHC_Strip_Image).
+
+Format (siehe xhc_strip.h): bis zu 16 Palettenfarben RGB565, danach ein
+Bytestrom über alle Zeilen hinweg:
+
+    Byte b:  Farbe = b >> 4,  Lauf = (b & 0x0F) + 1      (1..15)
+             b & 0x0F == 0x0F: Lauf = 16 + nächstes Byte  (16..271)
+
+Ändert sich das Layout in xhc_screen.c, hier die Konstanten nachziehen und
+das Skript neu laufen lassen:
+
+    ./gen_layout_image.py [--ppm vorschau.ppm]
+"""
+import os
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, HERE)
+from gen_fonts import SRC, load_table  # noqa: E402
+
+OUT_C = os.path.join(HERE, "..", "XHC HB04", "Core", "Src", "xhc_layout_img.c")
+
+W, H = 160, 128
+
+WHITE = 0xFFFF
+BLACK = 0x0000
+BLUE = 0x001F
+
+# ---- Geometrie wie in xhc_screen.c ----
+CHAR_W = 7
+VAL_Y = [2, 14, 26, 50, 62, 74]
+WC_MC_X = 2
+AXIS_X = 35
+DIV_Y = 42
+BLUE_Y = 96
+
+COL0_X0 = 2
+COL0_X1 = W // 2 - 2
+COL1_X0 = W // 2 + 2
+COL1_X1 = W - 2
+BARS_Y = BLUE_Y + 16
+BAR_H = 12
+BAR_LABEL_W = CHAR_W
+BAR_PAD = 3
+F_LABEL_X = COL0_X0
+F_BAR_X = F_LABEL_X + BAR_LABEL_W + BAR_PAD
+F_BAR_W = COL0_X1 - F_BAR_X
+S_LABEL_X = COL1_X0
+S_BAR_X = S_LABEL_X + BAR_LABEL_W + BAR_PAD
+S_BAR_W = COL1_X1 - S_BAR_X
+
+
+class Font:
+    def __init__(self, table, width, height):
+        self.rows = load_table(open(SRC, encoding="utf-8", errors="replace").read(), table)
+        self.w, self.h = width, height
+
+    def glyph(self, ch):
+        base = (ord(ch) - 32) * self.h
+        return self.rows[base:base + self.h]
+
+
+def fill(img, x, y, w, h, c):
+    for yy in range(max(y, 0), min(y + h, H)):
+        for xx in range(max(x, 0), min(x + w, W)):
+            img[yy][xx] = c
+
+
+def rect(img, x, y, w, h, c):
+    fill(img, x, y, w, 1, c)
+    fill(img, x, y + h - 1, w, 1, c)
+    fill(img, x, y, 1, h, c)
+    fill(img, x + w - 1, y, 1, h, c)
+
+
+def text(img, x, y, s, font, fg, bg):
+    for ch in s:
+        for r, bits in enumerate(font.glyph(ch)):
+            for c in range(font.w):
+                if 0 <= y + r < H and 0 <= x + c < W:
+                    img[y + r][x + c] = fg if bits & (0x8000 >> c) else bg
+        x += font.w
+
+
+def bar_frame(img, x, y, w, h):
+    rect(img, x, y, w, h, WHITE)
+    fill(img, x + w // 2, y + 1, 1, h - 2, WHITE)
+
+
+def render():
+    f13 = Font("Font13x13", 13, 13)
+    f7 = Font("Font7x10", 7, 10)
+    img = [[WHITE] * W for _ in range(H)]
+
+    fill(img, 0, BLUE_Y, W, H - BLUE_Y, BLUE)
+
+    text(img, WC_MC_X, VAL_Y[0], "WC", f13, BLACK, WHITE)
+    for i, a in enumerate("XYZ"):
+        text(img, AXIS_X, VAL_Y[i], a + ":", f13, BLACK, WHITE)
+    fill(img, 0, DIV_Y, W, 1, BLACK)
+    text(img, WC_MC_X, VAL_Y[3], "MC", f13, BLACK, WHITE)
+    for i, a in enumerate("XYZ"):
+        text(img, AXIS_X, VAL_Y[3 + i], a + ":", f13, BLACK, WHITE)
+
+    text(img, F_LABEL_X, BARS_Y, "F", f7, WHITE, BLUE)
+    text(img, S_LABEL_X, BARS_Y, "S", f7, WHITE, BLUE)
+    bar_frame(img, F_BAR_X, BARS_Y, F_BAR_W, BAR_H)
+    bar_frame(img, S_BAR_X, BARS_Y, S_BAR_W, BAR_H)
+    return img
+
+
+def encode(img):
+    pal = []
+    for row in img:
+        for c in row:
+            if c not in pal:
+                pal.append(c)
+    if len(pal) > 16:
+        sys.exit("Fehler: %d Farben, das Format kann 16" % len(pal))
+
+    px = [pal.index(c) for row in img for c in row]
+    out, i = [], 0
+    while i < len(px):
+        n = 1
+        while i + n < len(px) and px[i + n] == px[i] and n < 271:
+            n += 1
+        if n < 16:
+            out.append((px[i] << 4) | (n - 1))
+        else:
+            out += [(px[i] << 4) | 0x0F, n - 16]
+        i += n
+    return pal, out
+
+
+def decode(pal, data, n):
+    px, i = [], 0
+    while len(px) < n:
+        b = data[i]
+        i += 1
+        run = (b & 0x0F) + 1
+        if run == 16:
+            run = 16 + data[i]
+            i += 1
+        px += [pal[b >> 4]] * run
+    return px
+
+
+def write_ppm(path, img):
+    with open(path, "wb") as f:
+        f.write(b"P6 %d %d 255\n" % (W, H))
+        for row in img:
+            for c in row:
+                f.write(bytes(((c >> 11) << 3, ((c >> 5) & 0x3F) << 2, (c & 0x1F) << 3)))
+
+
+def main():
+    img = render()
+    pal, data = encode(img)
+    assert decode(pal, data, W * H) == [c for row in img for c in row]
+
+    if "--ppm" in sys.argv:
+        write_ppm(sys.argv[sys.argv.index("--ppm") + 1], img)
+
+    out = [
+        "/*",
+        " * xhc_layout_img.c",
+        " *",
+        " *  ERZEUGT von tools/gen_layout_image.py – nicht von Hand ändern.",
+        " *      Statisches Layout %dx%d, %d Farben, RLE %d Byte (roh %d Byte RGB565)"
+        % (W, H, len(pal), len(data), W * H * 2),
+        " */",
+        "",
+        '#include "xhc_layout_img.h"',
+        "",
+        "static const uint16_t s_palette[%d] = {" % len(pal),
+        "    " + ", ".join("0x%04X" % c for c in pal),
+        "};",
+        "",
+        "static const uint8_t s_rle[%d] = {" % len(data),
+    ]
+    for i in range(0, len(data), 16):
+        out.append("    " + ",".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+    out += [
+        "};",
+        "",
+        "const XHC_RleImage XHC_Layout_Image = {",
+        "    %d, %d, %d, s_palette, s_rle, sizeof(s_rle)" % (W, H, len(pal)),
+        "};",
+        "",
+    ]
+    with open(OUT_C, "w", encoding="utf-8", newline="\n") as f:
+        f.write("\n".join(out))
+    print("%s: %d Farben, %d Byte" % (os.path.relpath(OUT_C), len(pal), len(data)))
+
+
+if __name__ == "__main__":
+    main()
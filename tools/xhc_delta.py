@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""Referenz-Encoder für Delta-Reports (Output 0x0E, Schnellmodus).
+
+Statt jedes Mal den ganzen 37-Byte-Frame (Output 0x0D) zu schicken, sendet
+der Host nur eine Bitmaske und die geänderten Felder. Die Firmware
+(Apply_Delta in xhc_screen.c) schreibt sie in den zuletzt empfangenen Frame
+und formatiert/zeichnet nur die geänderten Achsen neu.
+
+Report:  [0x0E][mask lo][mask hi][Felder in Bit-Reihenfolge, little endian]
+
+    Bit 0..5   pos[i]        4 Byte (p_int, p_frac)  Xw Yw Zw Xm Ym Zm
+    Bit 6      feedrate_ovr  2 Byte
+    Bit 7      sspeed_ovr    2 Byte
+    Bit 8      feedrate      2 Byte
+    Bit 9      sspeed        2 Byte
+    Bit 10     step_mul      1 Byte
+    Bit 11     state         1 Byte
+    Bit 12     day           1 Byte
+
+Ein Delta setzt immer einen Basis-Frame voraus. DeltaEncoder schickt deshalb
+den ersten Frame und danach alle KEYFRAME_EVERY Reports einen ganzen Frame
+(0x0D), damit ein verlorener Report oder ein Neustart des Geräts sich
+selbst korrigiert.
+
+    ./xhc_delta.py --selftest
+"""
+import random
+import struct
+import sys
+
+FRAME_OUT_ID, DELTA_OUT_ID = 0x0D, 0x0E
+FRAME_SIZE = 37
+REPORT_SIZE = 64
+MAGIC = b"\xFE\xFD"
+KEYFRAME_EVERY = 50
+
+# (Offset, Länge) je Maskenbit im 37-Byte-Frame, wie s_delta_off/len
+FIELDS = [(3 + 4 * i, 4) for i in range(6)] + [
+    (27, 2),  # feedrate_ovr
+    (29, 2),  # sspeed_ovr
+    (31, 2),  # feedrate
+    (33, 2),  # sspeed
+    (35, 1),  # step_mul
+    (36, 1),  # state
+    (2, 1),   # day
+]
+
+
+def pack_frame(pos, feed_ovr=10000, spindle_ovr=100, feed=0, spindle=0,
+               step_mul=0, state=0, day=0):
+    """37-Byte-Frame aus 6 Positionen (p_int, p_frac) bauen."""
+    body = b"".join(struct.pack("<HH", pi, pf) for pi, pf in pos)
+    return (MAGIC + bytes([day]) + body +
+            struct.pack("<HHHHBB", feed_ovr, spindle_ovr, feed, spindle, step_mul, state))
+
+
+def pad(rep):
+    return bytes(rep) + bytes(REPORT_SIZE - len(rep))
+
+
+def full_report(frame):
+    assert len(frame) == FRAME_SIZE and frame[:2] == MAGIC
+    return pad(bytes([FRAME_OUT_ID]) + frame)
+
+
+def delta_report(prev, frame):
+    """Delta-Report von prev nach frame, None wenn sich nichts geändert hat."""
+    mask, body = 0, b""
+    for bit, (off, n) in enumerate(FIELDS):
+        if frame[off:off + n] != prev[off:off + n]:
+            mask |= 1 << bit
+            body += frame[off:off + n]
+    if not mask:
+        return None
+    return pad(bytes([DELTA_OUT_ID]) + struct.pack("<H", mask) + body)
+
+
+def apply_delta(frame, rep):
+    """Gegenstück zur Firmware: Delta auf frame anwenden (für Tests)."""
+    assert rep[0] == DELTA_OUT_ID
+    mask = rep[1] | (rep[2] << 8)
+    if mask >> len(FIELDS):
+        raise ValueError("unbekannte Bits in der Maske: 0x%04X" % mask)
+    out, p = bytearray(frame), 3
+    for bit, (off, n) in enumerate(FIELDS):
+        if mask & (1 << bit):
+            out[off:off + n] = rep[p:p + n]
+            p += n
+    return bytes(out)
+
+
+class DeltaEncoder:
+    """Zustandsbehafteter Encoder: Frame rein, zu sendender Report raus."""
+
+    def __init__(self, keyframe_every=KEYFRAME_EVERY):
+        self.prev = None
+        self.count = 0
+        self.keyframe_every = keyframe_every
+
+    def reset(self):
+        """Nach Reconnect/Moduswechsel: nächster Report ist ein ganzer Frame."""
+        self.prev = None
+
+    def encode(self, frame):
+        if self.prev is None or self.count % self.keyframe_every == 0:
+            rep = full_report(frame)
+        else:
+            rep = delta_report(self.prev, frame)
+        self.count += 1
+        if rep is not None:
+            self.prev = frame
+        return rep
+
+
+def selftest():
+    rnd = random.Random(1)
+    pos = [(rnd.randrange(1000), rnd.randrange(10000)) for _ in range(6)]
+    frame = pack_frame(pos)
+    enc, dev = DeltaEncoder(), None
+    sent = full = 0
+    for _ in range(2000):
+        # typisch: eine Achse fährt, gelegentlich ändert sich ein Override
+        i = rnd.randrange(6)
+        pos[i] = (pos[i][0], (pos[i][1] + rnd.randrange(1, 50)) % 10000)
+        frame = pack_frame(pos, feed_ovr=10000 + 500 * rnd.randrange(3))
+        rep = enc.encode(frame)
+        if rep is None:
+            continue
+        if rep[0] == FRAME_OUT_ID:
+            dev = rep[1:1 + FRAME_SIZE]
+            full += 1
+            sent += 1 + FRAME_SIZE
+        else:
+            dev = apply_delta(dev, rep)
+            mask = rep[1] | (rep[2] << 8)
+            sent += 3 + sum(n for b, (_, n) in enumerate(FIELDS) if mask & (1 << b))
+        assert dev == frame
+    print("ok: 2000 Frames, %d Schlüsselbilder, %.1f Nutzbytes/Frame statt %d"
+          % (full, sent / 2000.0, 1 + FRAME_SIZE))
+
+
+if __name__ == "__main__":
+    if "--selftest" in sys.argv:
+        selftest()
+    else:
+        print(__doc__)
@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+"""Host-Modell des Bewegungsschätzers (xhc_estim.c) und der Interpolation.
+
+Rechnet XHC_Est_Update/XHC_Est_Extrapolate mit derselben Ganzzahl-
+Arithmetik wie die Firmware (Q8-Geschwindigkeit, dt in Q16, 1/dt in Q14),
+damit sich alpha/beta und XHC_EST_JUMP am Rechner prüfen lassen, bevor sie
+in xhc_config.h landen. Positionen in 1/10000 Einheit wie im Frame.
+
+Simuliert wird eine Achse: Host-Frames alle FRAME_MS, die Anzeige rechnet
+alle TICK_MS den Frame-Wert plus Extrapolation (wie Interp_Dirty in
+xhc_screen.c) und wird mit der wahren Bahn verglichen.
+
+    ./xhc_estim.py --selftest
+    ./xhc_estim.py [--alpha 128] [--beta 43] [--jump 200000]
+"""
+import argparse
+import sys
+
+ALPHA, BETA, JUMP = 128, 43, 200000      # XHC_EST_ALPHA/BETA/JUMP
+GAP_MS = 500                             # XHC_EST_GAP_MS
+INTERP_MAX_MS = 100                      # XHC_INTERP_MAX_MS
+FRAME_MS, TICK_MS = 50, 40               # 20 Frames/s, XHC_INTERP_PERIOD_MS
+
+EST_MIN_DT_US = 1000
+EST_ACC_K = 64
+EST_STILL = 2
+SAT = 1 << 30
+
+
+def sat30(v):
+    return max(-SAT, min(SAT, v))
+
+
+def cdiv(a, b):
+    """Division wie in C (Richtung null)."""
+    q = abs(a) // abs(b)
+    return q if (a < 0) == (b < 0) else -q
+
+
+class Estimator:
+    """Eine Achse von XHC_Est_Update/XHC_Est_Extrapolate, Zeit in us."""
+
+    def __init__(self, alpha=ALPHA, beta=BETA, jump=JUMP):
+        self.alpha, self.beta, self.jump = alpha, beta, jump
+        self.init = False
+        self.t = self.frame_t = 0
+        self.resets = 0
+
+    def _reset(self, z):
+        self.pos, self.vel, self.acc = z, 0, 0
+        self.v_q8, self.last_z, self.same = 0, z, 0
+
+    def update(self, z, t_us):
+        dt_us = t_us - self.t
+        self.frame_t = t_us
+        if not self.init or dt_us > GAP_MS * 1000:
+            self._reset(z)
+            self.t, self.init = t_us, True
+            return
+        if dt_us < EST_MIN_DT_US:
+            return
+        self.t = t_us
+        dt_q16 = (dt_us * 4295) >> 16
+        inv_dt = (1 << 30) // dt_q16
+
+        if z == self.last_z:
+            self.same = min(self.same + 1, EST_STILL)
+            if self.same >= EST_STILL:
+                self._reset(z)
+                self.same = EST_STILL
+                return
+        else:
+            self.same = 0
+        self.last_z = z
+
+        xp = self.pos + ((self.v_q8 * dt_q16) >> 24)
+        r = z - xp
+        if abs(r) > self.jump:
+            self._reset(z)
+            self.resets += 1
+            return
+        self.pos = xp + ((r * self.alpha) >> 8)
+        dv = sat30((r * inv_dt * self.beta) >> 14)
+        self.v_q8 = sat30(self.v_q8 + dv)
+        a = sat30((dv * inv_dt) >> 22)
+        self.acc += ((a - self.acc) * EST_ACC_K) >> 8
+        self.vel = self.v_q8 >> 8
+
+    def extrapolate(self, t_us, max_ms=INTERP_MAX_MS):
+        v = self.vel
+        if not self.init or not v or self.same:
+            return 0
+        dt_us = min(t_us - self.frame_t, max_ms * 1000, GAP_MS * 1000)
+        dt_q16 = (dt_us * 4295) >> 16
+        a = self.acc
+        if a and (a < 0) != (v < 0) and (abs(a) * dt_q16) >> 16 >= abs(v):
+            return cdiv(v * abs(v), 2 * abs(a))
+        return ((v * dt_q16) >> 16) + ((a * dt_q16 * dt_q16) >> 33)
+
+
+def profile(feed, acc, hold_s):
+    """Anfahren, hold_s konstant, Bremsen; feed in Einheit/min, acc in
+    Einheit/s². Liefert true(t_us) in 1/10000 Einheit und die Dauer."""
+    v = feed / 60.0
+    ta = v / acc
+    t1, t2 = ta, ta + hold_s
+    end = t2 + ta
+
+    def true(t_us):
+        t = t_us / 1e6
+        if t <= 0:
+            return 0
+        if t < t1:
+            s = 0.5 * acc * t * t
+        elif t < t2:
+            s = 0.5 * acc * t1 * t1 + v * (t - t1)
+        elif t < end:
+            d = t - t2
+            s = 0.5 * acc * t1 * t1 + v * hold_s + v * d - 0.5 * acc * d * d
+        else:
+            s = acc * t1 * t1 + v * hold_s
+        return int(round(s * 10000))
+
+    return true, int(end * 1e6)
+
+
+def run(feed=3000, acc=500, hold_s=1.0, alpha=ALPHA, beta=BETA, jump=JUMP,
+        frame_ms=FRAME_MS, tick_ms=TICK_MS):
+    """Größter Fehler der Anzeige (Frame + Extrapolation) gegen die wahre
+    Bahn, in 1/10000 Einheit: beim Bremsen, beim Bremsen ohne Interpolation
+    (nur Frame-Wert), nach dem Stillstand (Überlauf bis der Schätzer steht),
+    dazu der Endfehler, der Zeitpunkt des letzten Fehlers nach dem Stopp
+    (ms) und die Zahl der Sprünge."""
+    true, end = profile(feed, acc, hold_s)
+    est = Estimator(alpha, beta, jump)
+    brake_from = end - int(feed / 60.0 / acc * 1e6)
+    frame_z = true(0)
+    est.update(frame_z, 0)
+    brake = frame = over = 0
+    settle = 0
+    t, next_frame = 0, frame_ms * 1000
+    while t <= end + 500 * 1000:
+        t += tick_ms * 1000
+        while next_frame <= t:
+            frame_z = true(next_frame)
+            est.update(frame_z, next_frame)
+            next_frame += frame_ms * 1000
+        e = abs(frame_z + est.extrapolate(t) - true(t))
+        if brake_from <= t <= end:
+            brake = max(brake, e)
+            frame = max(frame, abs(frame_z - true(t)))
+        elif t > end and e:
+            over = max(over, e)
+            settle = (t - end) // 1000
+    final = frame_z + est.extrapolate(t) - true(t)
+    return brake, frame, over, final, settle, est.resets
+
+
+def selftest():
+    # Vorgaben aus xhc_config.h: 20 Frames/s, 40-ms-Ticks. Beim Bremsen muss
+    # die Interpolation näher an der Bahn liegen als der nackte Frame-Wert;
+    # ein Überlauf nach dem Stopp ist spätestens nach zwei Frames weg.
+    for feed, acc in ((1000, 200), (3000, 500), (6000, 1000)):
+        brake, frame, over, final, settle, resets = run(feed, acc)
+        assert brake < frame, (feed, acc, brake, frame)
+        assert final == 0 and resets == 0, (feed, acc, final, resets)
+        assert settle <= 2 * FRAME_MS, (feed, acc, settle)
+        print("ok: F%d a%d  Bremsen max %.4f mm (nur Frames %.4f),"
+              " Überlauf nach Stopp %.4f mm für %d ms"
+              % (feed, acc, brake / 10000.0, frame / 10000.0,
+                 over / 10000.0, settle))
+
+    # Sprung (Nullpunkt gesetzt, Achse referenziert): sofort übernommen
+    est = Estimator()
+    for k in range(10):
+        est.update(k * 2500, k * 50000)
+    est.update(5000000, 10 * 50000)
+    assert est.resets == 1 and est.pos == 5000000 and est.vel == 0
+
+    # 128/43 ist kritisch gedämpft: aus dem Stand auf konstante Fahrt
+    # höchstens 5 % Überschwingen, nach 3 s eingeschwungen
+    est, over = Estimator(), 0
+    for k in range(60):
+        est.update(k * 2500, k * 50000)
+        over = max(over, est.vel - 50000)
+    assert abs(est.vel - 50000) <= 50 and over <= 2500, (est.vel, over)
+    print("ok: Sprung ab %d, v-Überschwingen %.1f %%" % (JUMP, over / 500.0))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--selftest", action="store_true")
+    ap.add_argument("--alpha", type=int, default=ALPHA)
+    ap.add_argument("--beta", type=int, default=BETA)
+    ap.add_argument("--jump", type=int, default=JUMP)
+    ap.add_argument("--feed", type=int, default=3000, help="Einheit/min")
+    ap.add_argument("--acc", type=int, default=500, help="Einheit/s²")
+    args = ap.parse_args()
+    if args.selftest:
+        selftest()
+        return
+    brake, frame, over, final, settle, resets = run(
+        args.feed, args.acc, alpha=args.alpha, beta=args.beta, jump=args.jump)
+    print("Bremsen max %.4f (nur Frames %.4f), Überlauf %.4f für %d ms,"
+          " Endfehler %.4f Einheit, %d Sprünge"
+          % (brake / 10000.0, frame / 10000.0, over / 10000.0, settle,
+             final / 10000.0, resets))
+
+if __name__ == "__main__":
+    sys.exit(main())
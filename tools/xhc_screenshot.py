@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""Screenshot des Pendant-Displays über USB auslesen.
+
+Benötigt eine Firmware mit XHC_SHADOW_FB=1. Das Gerät schickt nach einem
+Feature-Report 0x0A erst die Palette (16 x RGB565) und dann den 4bpp-Puffer
+(160x128, gerades x im oberen Nibble) als Input-Reports 0x0B.
+
+    pip install hidapi
+    ./xhc_screenshot.py shot.ppm
+"""
+import sys
+
+import hid
+
+VID = 0x10CE
+PIDS = (0xEB70, 0xEB93)   # HB03/HB04, WHB04B (XHC_PROTO)
+W, H = 160, 128
+REQ_ID, DATA_ID, PALETTE = 0x0A, 0x0B, 0xFFFF
+
+
+def rgb565_to_rgb(c):
+    r = (c >> 11) & 0x1F
+    g = (c >> 5) & 0x3F
+    b = c & 0x1F
+    return (r * 255 // 31, g * 255 // 63, b * 255 // 31)
+
+
+def grab(dev, timeout_ms=2000):
+    dev.send_feature_report([REQ_ID] + [0] * 7)
+    pal = None
+    fb = bytearray(W * H // 2)
+    got = 0
+    while got < len(fb):
+        rep = dev.read(64, timeout_ms)
+        if not rep:
+            raise TimeoutError("keine Screenshot-Daten (XHC_SHADOW_FB aktiv?)")
+        if rep[0] != DATA_ID:
+            continue
+        off = rep[1] | (rep[2] << 8)
+        n = rep[3]
+        data = bytes(rep[4:4 + n])
+        if off == PALETTE:
+            pal = [data[i] | (data[i + 1] << 8) for i in range(0, 32, 2)]
+        else:
+            fb[off:off + n] = data
+            got = off + n
+    return pal, fb
+
+
+def write_ppm(path, pal, fb):
+    rgb = [rgb565_to_rgb(c) for c in pal]
+    with open(path, "wb") as f:
+        f.write(b"P6\n%d %d\n255\n" % (W, H))
+        for b in fb:
+            f.write(bytes(rgb[b >> 4]))
+            f.write(bytes(rgb[b & 0x0F]))
+
+
+def main():
+    out = sys.argv[1] if len(sys.argv) > 1 else "xhc_screenshot.ppm"
+    dev = hid.device()
+    for pid in PIDS:
+        try:
+            dev.open(VID, pid)
+            break
+        except (IOError, OSError):
+            continue
+    else:
+        sys.exit("kein Pendant gefunden")
+    try:
+        pal, fb = grab(dev)
+    finally:
+        dev.close()
+    write_ppm(out, pal, fb)
+    print("gespeichert:", out)
+
+
+if __name__ == "__main__":
+    main()
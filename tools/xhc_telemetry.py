@@ -0,0 +1,291 @@
+#!/usr/bin/env python3
+"""Telemetrie des Pendants mitschneiden und auswerten.
+
+Die Firmware (XHC_TELEMETRY=1, xhc_telemetry.c) schreibt Ereignisse als
+8-Byte-Datensätze mit DWT-Zeitstempel und schickt sie in Paketen über die
+CDC-Schnittstelle, sobald in der Konsole "tel on" eingegeben wurde:
+
+    Paket:     A5 5A n seq  n x Datensatz  xor(n .. letzter Datensatz)
+    Datensatz: u32 Zyklen, u8 Typ, u8 a8, u16 a16   (little endian)
+
+Konsolentext zwischen den Paketen wird überlesen. Ausgewertet werden
+Latenz-Histogramme (Report -> Frame, Frame -> Zeichnen, Zeichendauer,
+Eingang -> Anzeige) und auf Wunsch eine Zeitleiste.
+
+    ./xhc_telemetry.py /dev/ttyACM0 --seconds 10 --save mitschnitt.bin
+    ./xhc_telemetry.py mitschnitt.bin --timeline
+    ./xhc_telemetry.py --selftest
+"""
+import argparse
+import os
+import struct
+import sys
+import time
+
+SYNC = b"\xA5\x5A"
+REC = struct.Struct("<IBBH")
+MAX_RECORDS = 15
+
+TEL_RX, TEL_RX_DROP, TEL_FRAME, TEL_RENDER_BEG, TEL_RENDER_END, TEL_TX, TEL_LOST = range(1, 8)
+NAMES = {
+    TEL_RX: "rx",
+    TEL_RX_DROP: "rx-drop",
+    TEL_FRAME: "frame",
+    TEL_RENDER_BEG: "render-beg",
+    TEL_RENDER_END: "render-end",
+    TEL_TX: "tx",
+    TEL_LOST: "lost",
+}
+FRAME_KIND = {0: "chunks", 1: "ganz", 2: "delta"}
+DROP_REASON = {1: "ring voll", 2: "modus"}
+
+
+# ---------------------------------------------------------------- Mitschnitt
+
+def capture(dev, seconds):
+    """Rohdaten vom CDC-Port lesen; schaltet die Telemetrie an und wieder aus."""
+    import termios
+    import tty
+
+    fd = os.open(dev, os.O_RDWR | os.O_NOCTTY)
+    try:
+        tty.setraw(fd)
+        termios.tcflush(fd, termios.TCIFLUSH)
+        os.write(fd, b"tel on\r")
+        data = bytearray()
+        end = time.time() + seconds
+        os.set_blocking(fd, False)
+        while time.time() < end:
+            try:
+                chunk = os.read(fd, 4096)
+            except BlockingIOError:
+                chunk = b""
+            if chunk:
+                data += chunk
+            else:
+                time.sleep(0.005)
+        os.write(fd, b"tel off\r")
+        return bytes(data)
+    finally:
+        os.close(fd)
+
+
+# ---------------------------------------------------------------- Dekoder
+
+def packets(data):
+    """(seq, [(zyklen, typ, a8, a16), ...]) je gültigem Paket."""
+    i = 0
+    while True:
+        i = data.find(SYNC, i)
+        if i < 0 or i + 4 > len(data):
+            return
+        n, seq = data[i + 2], data[i + 3]
+        end = i + 4 + n * REC.size
+        if n == 0 or n > MAX_RECORDS or end + 1 > len(data):
+            i += 1
+            continue
+        x = 0
+        for b in data[i + 2:end]:
+            x ^= b
+        if x != data[end]:
+            i += 1
+            continue
+        recs = [REC.unpack_from(data, i + 4 + k * REC.size) for k in range(n)]
+        yield seq, recs
+        i = end + 1
+
+
+def decode(data, mhz=48.0):
+    """Ereignisliste mit Zeit in µs (Zyklenüberlauf aufgelöst) + Paketverluste."""
+    events, gaps = [], 0
+    last_seq, last_cyc, base = None, None, 0
+    for seq, recs in packets(data):
+        if last_seq is not None and seq != (last_seq + 1) & 0xFF:
+            gaps += (seq - last_seq - 1) & 0xFF
+        last_seq = seq
+        for cyc, typ, a8, a16 in recs:
+            if last_cyc is not None and cyc < last_cyc:
+                base += 1 << 32
+            last_cyc = cyc
+            events.append(((base + cyc) / mhz, typ, a8, a16))
+    return events, gaps
+
+
+# ---------------------------------------------------------------- Auswertung
+
+def latencies(events):
+    """Latenzreihen in µs aus der Ereignisfolge."""
+    out = {"report->frame": [], "frame->render": [], "render": [],
+           "eingang->anzeige": [], "tx-abstand": []}
+    last_rx = None          # letzter Report, der noch keinen Frame ergeben hat
+    first_pending = None    # ältester Eingang, der noch nicht angezeigt ist
+    last_frame = None
+    beg = None
+    last_tx = None
+    for t, typ, a8, a16 in events:
+        if typ == TEL_RX:
+            last_rx = t
+            if first_pending is None:
+                first_pending = t
+        elif typ == TEL_FRAME:
+            if last_rx is not None:
+                out["report->frame"].append(t - last_rx)
+                last_rx = None
+            if last_frame is None:
+                last_frame = t
+        elif typ == TEL_RENDER_BEG:
+            beg = t
+            if a8 == 2 and last_frame is not None:
+                out["frame->render"].append(t - last_frame)
+                last_frame = None
+        elif typ == TEL_RENDER_END:
+            if beg is not None:
+                out["render"].append(t - beg)
+                beg = None
+            if first_pending is not None:
+                out["eingang->anzeige"].append(t - first_pending)
+                first_pending = None
+        elif typ == TEL_TX:
+            if last_tx is not None:
+                out["tx-abstand"].append(t - last_tx)
+            last_tx = t
+        elif typ == TEL_LOST:
+            # Lücke: Bezüge über den Verlust hinweg wären falsch
+            last_rx = first_pending = last_frame = beg = last_tx = None
+    return out
+
+
+def percentile(sorted_vals, p):
+    k = min(len(sorted_vals) - 1, int(round(p / 100.0 * (len(sorted_vals) - 1))))
+    return sorted_vals[k]
+
+
+def histogram(name, vals, width=40):
+    if not vals:
+        print("%s: keine Daten" % name)
+        return
+    v = sorted(vals)
+    print("%s: n=%d  min %.0f  p50 %.0f  p99 %.0f  max %.0f us"
+          % (name, len(v), v[0], percentile(v, 50), percentile(v, 99), v[-1]))
+    # Zweierpotenz-Eimer in µs
+    buckets = {}
+    for x in v:
+        b = 1
+        while b < x:
+            b <<= 1
+        buckets[b] = buckets.get(b, 0) + 1
+    peak = max(buckets.values())
+    for b in sorted(buckets):
+        bar = "#" * max(1, buckets[b] * width // peak)
+        print("  <= %7d us %6d %s" % (b, buckets[b], bar))
+
+
+def describe(typ, a8, a16):
+    if typ in (TEL_RX, TEL_TX):
+        return "id 0x%02X, %d Byte" % (a8, a16)
+    if typ == TEL_RX_DROP:
+        return "id 0x%02X, %s" % (a8, DROP_REASON.get(a16, a16))
+    if typ == TEL_FRAME:
+        return "%s, Felder 0x%04X" % (FRAME_KIND.get(a8, a8), a16)
+    if typ == TEL_RENDER_BEG:
+        return "%s, Felder 0x%04X" % ("live" if a8 == 1 else "frame", a16)
+    if typ == TEL_RENDER_END:
+        return "%s, Achsen 0x%02X" % ("live" if a8 == 1 else "frame", a16)
+    if typ == TEL_LOST:
+        return "%d Datensätze" % a16
+    return "a8 %d a16 %d" % (a8, a16)
+
+
+def timeline(events):
+    if not events:
+        return
+    t0 = events[0][0]
+    for t, typ, a8, a16 in events:
+        print("%12.3f ms  %-10s %s" % ((t - t0) / 1000.0, NAMES.get(typ, typ), describe(typ, a8, a16)))
+
+
+def report(events, gaps):
+    counts = {}
+    for _, typ, _, a16 in events:
+        counts[typ] = counts.get(typ, 0) + (a16 if typ == TEL_LOST else 1)
+    span = (events[-1][0] - events[0][0]) / 1e6 if events else 0.0
+    print("%d Ereignisse über %.2f s, %d Pakete verloren" % (len(events), span, gaps))
+    print("  " + ", ".join("%s %d" % (NAMES.get(k, k), counts[k]) for k in sorted(counts)))
+    print()
+    for name, vals in latencies(events).items():
+        histogram(name, vals)
+        print()
+
+
+# ---------------------------------------------------------------- Selbsttest
+
+def encode(records, seq=0):
+    """Pakete wie die Firmware bauen (für den Selbsttest)."""
+    out = bytearray()
+    for i in range(0, len(records), MAX_RECORDS):
+        chunk = records[i:i + MAX_RECORDS]
+        body = bytes([len(chunk), seq & 0xFF]) + b"".join(REC.pack(*r) for r in chunk)
+        x = 0
+        for b in body:
+            x ^= b
+        out += SYNC + body + bytes([x])
+        seq += 1
+    return bytes(out)
+
+
+def selftest():
+    mhz = 48
+    recs, t = [], (1 << 32) - 48 * 5000   # Zyklenüberlauf nach 5 ms
+    for k in range(200):
+        recs.append((t & 0xFFFFFFFF, TEL_RX, 0x0E, 20))
+        recs.append(((t + 48 * 30) & 0xFFFFFFFF, TEL_FRAME, 2, 0x0001))
+        recs.append(((t + 48 * 500) & 0xFFFFFFFF, TEL_RENDER_BEG, 2, 0x0001))
+        recs.append(((t + 48 * 2500) & 0xFFFFFFFF, TEL_RENDER_END, 2, 0x01))
+        t += 48 * 10000
+    data = b"tel on\r\ntel on, 0 logged, 0 lost\r\n" + encode(recs) + b"\xA5\x5A\x03garbage"
+    events, gaps = decode(data, mhz)
+    assert len(events) == len(recs) and gaps == 0
+    assert all(events[i][0] < events[i + 1][0] for i in range(len(events) - 1))
+    lat = latencies(events)
+    assert all(abs(x - 30) < 1e-6 for x in lat["report->frame"])
+    assert all(abs(x - 2000) < 1e-6 for x in lat["render"])
+    assert all(abs(x - 2500) < 1e-6 for x in lat["eingang->anzeige"])
+    print("ok: %d Ereignisse, Überlauf und Müll überstanden" % len(events))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("source", nargs="?", help="CDC-Gerät (/dev/ttyACM0) oder Mitschnitt")
+    ap.add_argument("--seconds", type=float, default=10.0, help="Mitschnittdauer am Gerät")
+    ap.add_argument("--save", help="Rohdaten zusätzlich speichern")
+    ap.add_argument("--mhz", type=float, default=48.0, help="CPU-Takt der Zeitstempel")
+    ap.add_argument("--timeline", action="store_true", help="Ereignisse einzeln ausgeben")
+    ap.add_argument("--selftest", action="store_true")
+    args = ap.parse_args()
+
+    if args.selftest:
+        selftest()
+        return
+    if not args.source:
+        ap.error("Quelle fehlt")
+
+    if args.source.startswith("/dev/"):
+        data = capture(args.source, args.seconds)
+    else:
+        with open(args.source, "rb") as f:
+            data = f.read()
+    if args.save:
+        with open(args.save, "wb") as f:
+            f.write(data)
+
+    events, gaps = decode(data, args.mhz)
+    if not events:
+        sys.exit("keine Telemetrie-Pakete gefunden (XHC_TELEMETRY aktiv?)")
+    if args.timeline:
+        timeline(events)
+        print()
+    report(events, gaps)
+
+
+if __name__ == "__main__":
+    main()